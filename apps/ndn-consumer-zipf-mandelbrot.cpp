@@ -80,17 +80,9 @@ ConsumerZipfMandelbrot::SetNumberOfContents(uint32_t numOfContents)
 
   NS_LOG_DEBUG(m_q << " and " << m_s << " and " << m_N);
 
-  m_Pcum = std::vector<double>(m_N + 1);
-
-  m_Pcum[0] = 0.0;
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i - 1] + 1.0 / std::pow(i + m_q, m_s);
-  }
-
-  for (uint32_t i = 1; i <= m_N; i++) {
-    m_Pcum[i] = m_Pcum[i] / m_Pcum[m_N];
-    NS_LOG_LOGIC("Cumulative probability [" << i << "]=" << m_Pcum[i]);
-  }
+  // the distribution is (re)built on first use, so that setting N, q, and s in a row only
+  // computes it once
+  m_distribution.reset();
 }
 
 uint32_t
@@ -103,7 +95,7 @@ void
 ConsumerZipfMandelbrot::SetQ(double q)
 {
   m_q = q;
-  SetNumberOfContents(m_N);
+  m_distribution.reset();
 }
 
 double
@@ -116,7 +108,7 @@ void
 ConsumerZipfMandelbrot::SetS(double s)
 {
   m_s = s;
-  SetNumberOfContents(m_N);
+  m_distribution.reset();
 }
 
 double
@@ -180,9 +172,9 @@ ConsumerZipfMandelbrot::SendPacket()
   // NS_LOG_INFO ("Requesting Interest: \n" << *interest);
   NS_LOG_INFO("> Interest for " << seq << ", Total: " << m_seq << ", face: " << m_face->getId());
   NS_LOG_DEBUG("Trying to add " << seq << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqTimeouts.GetSize() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(seq, Simulator::Now()));
+  m_seqTimeouts.Add(seq);
   m_seqFullDelay.insert(SeqTimeout(seq, Simulator::Now()));
 
   m_seqLastDelay.erase(seq);
@@ -201,24 +193,18 @@ ConsumerZipfMandelbrot::SendPacket()
 uint32_t
 ConsumerZipfMandelbrot::GetNextSeq()
 {
-  uint32_t content_index = 1; //[1, m_N]
-  double p_sum = 0;
+  if (m_distribution == nullptr) {
+    m_distribution = ZipfDistribution::Get(m_N, m_q, m_s);
+  }
 
   double p_random = m_seqRng->GetValue();
   while (p_random == 0) {
     p_random = m_seqRng->GetValue();
   }
-  // if (p_random == 0)
   NS_LOG_LOGIC("p_random=" << p_random);
-  for (uint32_t i = 1; i <= m_N; i++) {
-    p_sum = m_Pcum[i]; // m_Pcum[i] = m_Pcum[i-1] + p[i], p[0] = 0;   e.g.: p_cum[1] = p[1],
-                       // p_cum[2] = p[1] + p[2]
-    if (p_random <= p_sum) {
-      content_index = i;
-      break;
-    } // if
-  }   // for
-  // content_index = 1;
+
+  // binary search over the cumulative distribution: content_index in [1, m_N]
+  uint32_t content_index = m_distribution->GetRank(p_random);
   NS_LOG_DEBUG("RandomNumber=" << content_index);
   return content_index;
 }
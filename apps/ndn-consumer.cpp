@@ -85,6 +85,7 @@ Consumer::Consumer()
   NS_LOG_FUNCTION_NOARGS();
 
   m_rtt = CreateObject<RttMeanDeviation>();
+  m_seqTimeouts.SetCallback(std::bind(&Consumer::OnTimeouts, this, std::placeholders::_1));
 }
 
 void
@@ -109,24 +110,11 @@ Consumer::GetRetxTimer() const
 void
 Consumer::CheckRetxTimeout()
 {
-  Time now = Simulator::Now();
-
   Time rto = m_rtt->RetransmitTimeout();
   NS_LOG_INFO ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  while (!m_seqTimeouts.empty()) {
-    SeqTimeoutsContainer::index<i_timestamp>::type::iterator entry =
-      m_seqTimeouts.get<i_timestamp>().begin();
-    NS_LOG_INFO("ENTRY: " << entry->time + rto << " " << now);
-    if (entry->time + rto <= now) // timeout expired?
-    {
-      uint32_t seqNo = entry->seq;
-      m_seqTimeouts.get<i_timestamp>().erase(entry);
-      OnTimeout(seqNo);
-    }
-    else
-      break; // nothing else to do. All later packets need not be retransmitted
-  }
+  // expired sequence numbers are reported to OnTimeouts
+  m_seqTimeouts.Expire(rto);
 
   m_retxEvent = Simulator::Schedule(m_retxTimer, &Consumer::CheckRetxTimeout, this);
 }
@@ -228,11 +216,8 @@ Consumer::OnData(shared_ptr<const Data> data)
   int hopCount = 0;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-      NS_LOG_DEBUG("Hop count: " << hopCount);
-    }
+    hopCount = ns3PacketTag->getHopCount();
+    NS_LOG_DEBUG("Hop count: " << hopCount);
   }
 
   SeqTimeoutsContainer::iterator entry = m_seqLastDelay.find(seq);
@@ -249,7 +234,7 @@ Consumer::OnData(shared_ptr<const Data> data)
   m_seqFullDelay.erase(seq);
   m_seqLastDelay.erase(seq);
 
-  m_seqTimeouts.erase(seq);
+  m_seqTimeouts.Remove(seq);
   m_retxSeqs.erase(seq);
 
   m_rtt->AckSeq(SequenceNumber32(seq));
@@ -269,13 +254,20 @@ Consumer::OnTimeout(uint32_t sequenceNumber)
   ScheduleNextPacket();
 }
 
+void
+Consumer::OnTimeouts(const std::vector<uint32_t>& sequenceNumbers)
+{
+  for (uint32_t sequenceNumber : sequenceNumbers)
+    OnTimeout(sequenceNumber);
+}
+
 void
 Consumer::WillSendOutInterest(uint32_t sequenceNumber)
 {
   NS_LOG_DEBUG("Trying to add " << sequenceNumber << " with " << Simulator::Now() << ". already "
-                                << m_seqTimeouts.size() << " items");
+                                << m_seqTimeouts.GetSize() << " items");
 
-  m_seqTimeouts.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
+  m_seqTimeouts.Add(sequenceNumber);
   m_seqFullDelay.insert(SeqTimeout(sequenceNumber, Simulator::Now()));
 
   m_seqLastDelay.erase(sequenceNumber);
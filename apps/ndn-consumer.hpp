@@ -31,6 +31,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-timer.hpp"
 
 #include <set>
 #include <map>
@@ -70,6 +71,13 @@ public:
   virtual void
   OnTimeout(uint32_t sequenceNumber);
 
+  /**
+   * @brief Batch of timeouts reported by the retransmission timer
+   * @param sequenceNumbers time outed sequence numbers, in the order they were sent
+   */
+  void
+  OnTimeouts(const std::vector<uint32_t>& sequenceNumbers);
+
   /**
    * @brief Actually send packet
    */
@@ -195,7 +203,7 @@ protected:
                                                                          &SeqTimeout::time>>>> {
   };
 
-  SeqTimeoutsContainer m_seqTimeouts; ///< \brief multi-index for the set of SeqTimeout structs
+  RetxTimer<uint32_t> m_seqTimeouts; ///< \brief outstanding sequence numbers in send order
 
   SeqTimeoutsContainer m_seqLastDelay;
   SeqTimeoutsContainer m_seqFullDelay;
@@ -46,6 +46,7 @@
 
 #include "helper/ndn-global-routing-helper.hpp"
 #include "helper/ndn-link-control-helper.hpp"
+#include "helper/ndn-route-update-scheduler.hpp"
 
 #include "ndn-cxx/pdrm-strategy-selectors.hpp"
 
@@ -175,6 +176,7 @@ MobileUser::MobileUser()
   , m_movingReplicating(false)
   , m_usedCache(0)
 {
+  m_chunkTimeouts.SetCallback(std::bind(&MobileUser::OnTimeouts, this, std::placeholders::_1));
 }
 
 /**
@@ -274,49 +276,28 @@ MobileUser::GetRetxTimer() const
   
 /**
  * Periodically check the retransmission timeout.
- * Finds the Interest with the closest timeout.
- * Checks if that Interest expired (timeout).
- * If that is not the case, do nothing.
+ * Interests are kept in the order they were sent, so only the expired ones are visited.
+ * Expired Interests are handled by OnTimeouts.
  * Re-schedule the event.
  */
 void
 MobileUser::CheckRetxTimeout()
 {
-  Time now = Simulator::Now();
-
   Time rto = m_rtt->RetransmitTimeout();
 //  NS_LOG_INFO ("Current RTO: " << rto.ToDouble (Time::S) << "s");
 
-  pair<Name, Time> entry;
-
-  while (!m_chunkTimeouts.empty()) {
-
-    // looks for the closest expiring interest entry
-    entry = make_pair(m_chunkTimeouts.begin()->first, m_chunkTimeouts.begin()->second);
-    
-    for (map<Name, Time>::iterator it = m_chunkTimeouts.begin(); it != m_chunkTimeouts.end(); ++it)
-    {
-      if (it->second < entry.second)
-      {
-        entry = make_pair(it->first, it->second);
-      }   
-    }
-
-    // if it is timed out, process, and repeat the loop to find if the next one also expired
-    if (entry.second + rto <= now)
-    {
-      Name expiredInterest = entry.first;
-      m_chunkTimeouts.erase(entry.first);
-      OnTimeout(expiredInterest);
-    }
-    // otherwise, the others will not be expired
-    else
-      break;
-  }
+  m_chunkTimeouts.Expire(rto);
 
   m_retxEvent = Simulator::Schedule(m_retxTimer, &MobileUser::CheckRetxTimeout, this);
 }
 
+void
+MobileUser::OnTimeouts(const vector<Name>& objectNames)
+{
+  for (const Name& objectName : objectNames)
+    OnTimeout(objectName);
+}
+
 /**
  * Interest packet timeout handler.
  * Update retransmission and rtt statistics.
@@ -521,11 +502,8 @@ MobileUser::RespondData(shared_ptr<const Data> data)
   int hopCount = 0;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { 
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-      //NS_LOG_DEBUG("Hop count: " << hopCount);
-    }
+    hopCount = ns3PacketTag->getHopCount();
+    //NS_LOG_DEBUG("Hop count: " << hopCount);
   }
 
   // Update the data control structures
@@ -539,7 +517,7 @@ MobileUser::RespondData(shared_ptr<const Data> data)
   m_chunkFullDelay.erase(objectName);
   m_chunkLastDelay.erase(objectName);
 
-  m_chunkTimeouts.erase(objectName);
+  m_chunkTimeouts.Remove(objectName);
 
   m_rtt->AckSeq(m_chunkOrder[objectName]);
 
@@ -599,7 +577,7 @@ MobileUser::StartObjectDownload(Name objectName)
 
   m_requestedObjects.insert(objectName);
 
-  objectProperties properties = m_catalog->getObjectProperties(objectName);
+  const objectProperties& properties = m_catalog->getObjectProperties(objectName);
   shared_ptr<Name> interestName;
 
   // For each chunk, append the sequence number and add it to the interest queue
@@ -701,7 +679,7 @@ MobileUser::WillSendOutInterest(Name objectName)
   //NS_LOG_DEBUG("Trying to add " << objectName << " with " << Simulator::Now().ToDouble(Time::S) << " seconds. Already "
   //                              << m_nameTimeouts.size() << " items");
 
-  m_chunkTimeouts[objectName] = Simulator::Now();
+  m_chunkTimeouts.Add(objectName);
   m_chunkFullDelay[objectName] = Simulator::Now();
 
   m_chunkLastDelay.erase(objectName);
@@ -747,9 +725,8 @@ MobileUser::AnnounceContent(Name object)
   ndnGlobalRoutingHelper.AddOrigin(object.toUri(), this->GetNode());
 
   FibHelper::AddRoute(GetNode(), object, m_face, 0);
-  
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+
+  RouteUpdateScheduler::Get()->RequestUpdate(object);
 }
 
 void
@@ -761,8 +738,7 @@ MobileUser::UnannounceContent(Name object)
   FibHelper::RemoveRoute(GetNode(), object, m_face);
   m_providedObjects.erase(object);
 
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  RouteUpdateScheduler::Get()->RequestUpdate(object);
 }
 
 void
@@ -866,7 +842,7 @@ MobileUser::PublishContent()
 
   //generate content
   m_catalog->addObject(*newObject, m_producerPopularity);
-  objectProperties p = m_catalog->getObjectProperties(*newObject);
+  const objectProperties& p = m_catalog->getObjectProperties(*newObject);
 
   //advertise it
   vector<Ptr<Node>> users = m_catalog->getUsers();
@@ -962,7 +938,7 @@ void
 MobileUser::PushToSelectedDevices(Name objectName)
 {
   // figure out if object is underprovisioned
-  objectProperties properties = m_catalog->getObjectProperties(objectName);
+  const objectProperties& properties = m_catalog->getObjectProperties(objectName);
   if (m_sessionPeriod + m_movementPeriod == Time("0s"))
     m_userAvailability = 0;
   else
@@ -1041,7 +1017,7 @@ void
 MobileUser::PushToRandomDevices(Name objectName)
 {
   // figure out if object is underprovisioned
-  objectProperties properties = m_catalog->getObjectProperties(objectName);
+  const objectProperties& properties = m_catalog->getObjectProperties(objectName);
   if (m_sessionPeriod + m_movementPeriod == Time("0s"))
     m_userAvailability = 0;
   else
@@ -1211,8 +1187,7 @@ MobileUser::CourseChange(Ptr<const MobilityModel> model)
   }
   m_lastMovementEvent = Simulator::Now();
 
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  RouteUpdateScheduler::Get()->RequestUpdate();
 }
 
 
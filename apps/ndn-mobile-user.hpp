@@ -35,6 +35,8 @@
 #include "ns3/mobility-model.h"
 
 #include <utils/ndn-catalog.hpp>
+#include <utils/ndn-name-hash.hpp>
+#include <utils/ndn-retx-timer.hpp>
 
 #include <vector>
 #include <set>
@@ -110,6 +112,9 @@ public:
   virtual void
   OnTimeout(Name objectName);
 
+  void
+  OnTimeouts(const vector<Name>& objectNames);
+
   /* 
    * Packet/Event Handler
    * There are two main packets: Data and Interest.
@@ -309,7 +314,7 @@ private:
   Time m_retxTimer;
   EventId m_retxEvent;
   queue<Name> m_retxChunksQueue;
-  map<Name, Time> m_chunkTimeouts;
+  RetxTimer<Name, NameHash> m_chunkTimeouts;
  
   map<Name, Time> m_chunkLastDelay;
   map<Name, Time> m_chunkFullDelay;
@@ -67,6 +67,9 @@ PDRMConsumerBatch::StartApplication()
   m_warmup = true;
   m_execution = false;
 
+  m_retxTimer.SetTimeout(m_interestLifeTime);
+  CreateCongestionWindow();
+
   m_requestPeriod = CreateObject<ConstantRandomVariable>();
   m_requestPeriod->SetAttribute("Constant", DoubleValue(1.0 / m_lambdaRequests));
 
@@ -105,12 +108,12 @@ PDRMConsumerBatch::FindObject()
     ScheduleNextPacket();
   } else {
     NS_LOG_FUNCTION_NOARGS();
-    ContentObject object;
+    const ContentObject* object = nullptr;
     do {
-      object = m_catalog->getObjectRequest();  
-    } while (m_objectStartDownloadTime.count(object.name) > 0);
-    NS_LOG_INFO(object.name);
-    StartObjectDownload(object);
+      object = &m_catalog->getObjectRequest();
+    } while (m_downloads.isDownloading(object->name));
+    NS_LOG_INFO(object->name);
+    StartObjectDownload(*object);
   }
 }
 
@@ -137,6 +140,9 @@ PDRMConsumerBatch::GetNextPacket()
   Name chunk;
 
   if (m_requestsSent < m_batchSize) {
+    if (!CanSendInterest())
+      return;
+
     chunk = m_chunkRequest.front();
     m_chunkRequest.pop();
     SendPacket(chunk, false);
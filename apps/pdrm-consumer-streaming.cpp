@@ -69,6 +69,9 @@ PDRMConsumerStreaming::StartApplication()
 
   m_requestsSent = 0;
 
+  m_retxTimer.SetTimeout(m_interestLifeTime);
+  CreateCongestionWindow();
+
   m_requestPeriod = CreateObject<ConstantRandomVariable>();
   m_requestPeriod->SetAttribute("Constant", DoubleValue(1.0 / m_lambdaRequests));
 
@@ -88,6 +91,7 @@ void
 PDRMConsumerStreaming::StopApplication()
 {
   Simulator::Cancel(m_sendEvent);
+  m_retxTimer.Cancel();
   App::StopApplication();
 }
 
@@ -104,25 +108,28 @@ PDRMConsumerStreaming::OnTimeout(Name chunk)
 {
   if (m_warmup) return;
 
-  if (m_retxEvent.count(chunk) == 0)
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
+  if (id == PDRMDownloadState::INVALID_ID || !m_downloads.isPending(id, seqNumber))
     return;
 
-  Name object = chunk.getPrefix(2);
   NS_LOG_FUNCTION(chunk);
 
-  uint32_t seqNumber = chunk.at(-1).toSequenceNumber();
-
-  m_chunkFirstRequest.erase(chunk);
-  m_chunkLastRequest.erase(chunk);
-  m_chunkRequestCount.erase(chunk);
+  const PDRMDownloadState::Chunk& record = m_downloads.getChunk(id, seqNumber);
+  m_chunkFailedDelay(this, chunk, seqNumber, Simulator::Now() - record.firstRequest,
+    Simulator::Now() - record.lastRequest, record.requestCount, m_maxHopCount);
 
-  m_chunkFailedDelay(this, chunk, seqNumber, Simulator::Now() - m_chunkFirstRequest[chunk],
-    Simulator::Now() - m_chunkLastRequest[chunk], m_chunkRequestCount[chunk], m_maxHopCount);
+  // no retransmission when streaming
+  m_downloads.clearChunk(id, seqNumber);
+  UpdateWindowOnTimeout();
   
-  m_objectTimeouts[object]++;
+  PDRMDownloadState::Object& object = m_downloads.getObject(id);
+  object.timeouts++;
 
-  if (seqNumber+1 == m_objectSize[object])
-    ConcludeObjectDownload(object);
+  if (seqNumber+1 == object.size)
+    ConcludeObjectDownload(object.name);
+
+  ResumeSending();
 
 }
 
@@ -136,11 +143,11 @@ PDRMConsumerStreaming::OnData(shared_ptr<const Data> data)
 
   App::OnData(data);
 
-  Name chunk = data->getName();
-  Name object = chunk.getPrefix(2);
-  uint32_t seqNumber = chunk.at(-1).toSequenceNumber();
+  const Name& chunk = data->getName();
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
  
-  if (m_chunksMap[object][seqNumber])
+  if (id == PDRMDownloadState::INVALID_ID || m_downloads.isReceived(id, seqNumber))
     return;
   NS_LOG_FUNCTION_NOARGS();
 
@@ -148,29 +155,23 @@ PDRMConsumerStreaming::OnData(shared_ptr<const Data> data)
   uint32_t hopCount = 0;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { 
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-    }
+    hopCount = ns3PacketTag->getHopCount();
   }
   m_maxHopCount = max(m_maxHopCount, hopCount);
 
-  m_chunkRetrievalDelay(this, chunk, seqNumber, Simulator::Now() - m_chunkFirstRequest[chunk],
-    Simulator::Now() - m_chunkLastRequest[chunk], m_chunkRequestCount[chunk], hopCount);
+  const PDRMDownloadState::Chunk& record = m_downloads.getChunk(id, seqNumber);
+  m_chunkRetrievalDelay(this, chunk, seqNumber, Simulator::Now() - record.firstRequest,
+    Simulator::Now() - record.lastRequest, record.requestCount, hopCount);
 
-  m_chunkFirstRequest.erase(chunk);
-  m_chunkLastRequest.erase(chunk);
-  m_chunkRequestCount.erase(chunk);
+  m_retxTimer.Remove(chunk);
+  UpdateWindowOnData(id, seqNumber);
+  m_downloads.markReceived(id, seqNumber);
 
-  Simulator::Remove(m_retxEvent[chunk]);
-  m_retxEvent.erase(chunk);
+  const PDRMDownloadState::Object& object = m_downloads.getObject(id);
+  if (seqNumber+1 == object.size)
+    ConcludeObjectDownload(object.name);
 
-  //NS_LOG_INFO(object << " " << seqNumber << " " << m_chunksMap[object][seqNumber] << " " << m_chunksDownloaded[object]);
-
-  m_chunksMap[object][seqNumber] = true;
-
-  if (seqNumber+1 == m_objectSize[object])
-    ConcludeObjectDownload(object);
+  ResumeSending();
 }
 
 /**
@@ -190,12 +191,12 @@ PDRMConsumerStreaming::FindObject()
     ScheduleNextPacket();
   } else {
     NS_LOG_FUNCTION_NOARGS();
-    ContentObject object;
+    const ContentObject* object = nullptr;
     do {
-      object = m_catalog->getObjectRequest();
-    } while (m_objectStartDownloadTime.count(object.name) > 0);
-    NS_LOG_INFO(object.name);
-    StartObjectDownload(object);
+      object = &m_catalog->getObjectRequest();
+    } while (m_downloads.isDownloading(object->name));
+    NS_LOG_INFO(object->name);
+    StartObjectDownload(*object);
   }
 }
 
@@ -203,23 +204,18 @@ PDRMConsumerStreaming::FindObject()
  * 
  */
 void
-PDRMConsumerStreaming::StartObjectDownload(ContentObject object)
+PDRMConsumerStreaming::StartObjectDownload(const ContentObject& object)
 {
-  shared_ptr<Name> interestName;
-
   // For each chunk, append the sequence number and add it to the interest queue
   for (uint32_t i = 0; i < object.size; i++) {
-    interestName = make_shared<Name>(object.name);
-    interestName->appendSequenceNumber(i);
-    m_chunkRequest.push(*interestName);
+    Name interestName = object.name;
+    interestName.appendSequenceNumber(i);
+    m_chunkRequest.push(interestName);
   }
 
   NS_LOG_INFO(object.name << " " << object.locality << " @ " << m_position);
 
-  m_objectStartDownloadTime[object.name] = Simulator::Now();
-  m_objectSize[object.name] = object.size;
-  m_objectTimeouts[object.name] = 0;
-  m_chunksMap[object.name] = map<uint32_t, bool>();
+  m_downloads.startObject(object.name, object.size);
 
   ScheduleNextPacket();
 }
@@ -247,6 +243,9 @@ PDRMConsumerStreaming::GetNextPacket()
   Name chunk;
 
   if (m_requestsSent < m_batchSize) {
+    if (!CanSendInterest())
+      return;
+
     chunk = m_chunkRequest.front();
     m_chunkRequest.pop();
     SendPacket(chunk, false);
@@ -268,8 +267,6 @@ PDRMConsumerStreaming::SendPacket(Name chunk, bool retransmission)
     return;
   NS_LOG_FUNCTION_NOARGS();
 
-  Name object = chunk.getPrefix(2);
-
   // Create interest packet
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
@@ -282,7 +279,11 @@ PDRMConsumerStreaming::SendPacket(Name chunk, bool retransmission)
   m_transmittedInterests(interest, this, m_face);
   m_face->onReceiveInterest(*interest);
 
-  m_retxEvent[chunk] = Simulator::Schedule(m_interestLifeTime, &PDRMConsumerStreaming::OnTimeout, this, chunk);
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
+  if (id != PDRMDownloadState::INVALID_ID)
+    m_retxTimer.Add(chunk);
+  m_inFlight = m_downloads.getPendingCount();
 
   ScheduleNextPacket();
 }
@@ -293,10 +294,12 @@ PDRMConsumerStreaming::SendPacket(Name chunk, bool retransmission)
 void
 PDRMConsumerStreaming::WillSendOutInterest(Name chunk)
 {
-  m_chunkFirstRequest[chunk] = Simulator::Now();
-  m_chunkLastRequest[chunk] = Simulator::Now();
-
-  m_chunkRequestCount[chunk] = 1;
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
+  if (id != PDRMDownloadState::INVALID_ID) {
+    m_downloads.clearChunk(id, seqNumber);
+    m_downloads.recordRequest(id, seqNumber);
+  }
 }
 
 /**
@@ -305,14 +308,16 @@ PDRMConsumerStreaming::WillSendOutInterest(Name chunk)
 void
 PDRMConsumerStreaming::ConcludeObjectDownload(Name object)
 {
-  m_objectDownloadTime(this, object, Simulator::Now() - m_objectStartDownloadTime[object], m_objectTimeouts[object]);
+  uint32_t id = m_downloads.getObjectId(object);
+  if (id == PDRMDownloadState::INVALID_ID)
+    return;
+
+  const PDRMDownloadState::Object& entry = m_downloads.getObject(id);
+  m_objectDownloadTime(this, object, Simulator::Now() - entry.startTime, entry.timeouts);
 
   NS_LOG_INFO(object);
 
-  m_objectStartDownloadTime.erase(object);
-  m_objectSize.erase(object);
-  m_objectTimeouts.erase(object);
-  m_chunksMap.erase(object);
+  m_downloads.concludeObject(id);
 }
 
 } // namespace ndn
@@ -58,7 +58,7 @@ public:
   FindObject();
 
   virtual void
-  StartObjectDownload(ContentObject object);
+  StartObjectDownload(const ContentObject& object);
 
   virtual void
   ScheduleNextPacket();
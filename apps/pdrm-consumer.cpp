@@ -90,6 +90,13 @@ PDRMConsumer::GetTypeId(void)
                     MakeIntegerAccessor(&PDRMConsumer::m_position),
                     MakeIntegerChecker<uint32_t>())
 
+      .AddAttribute("CongestionWindow",
+                    "Type of the congestion window: ns3::ndn::PDRMFixedWindow, "
+                    "ns3::ndn::PDRMAimdWindow, or ns3::ndn::PDRMCubicWindow",
+                    StringValue("ns3::ndn::PDRMFixedWindow"),
+                    MakeStringAccessor(&PDRMConsumer::m_congestionWindowType),
+                    MakeStringChecker())
+
       // Global
       .AddAttribute("Catalog",
                     "Content catalog",
@@ -122,14 +129,29 @@ PDRMConsumer::GetTypeId(void)
       .AddTraceSource("ObjectFailedDownload",
                       "Failed to download an object",
                       MakeTraceSourceAccessor(&PDRMConsumer::m_objectFailedDownload),
-                      "ns3::ndn::PDRMConsumer::ObjectFailedDownloadCallback");
+                      "ns3::ndn::PDRMConsumer::ObjectFailedDownloadCallback")
+
+      .AddTraceSource("WindowTrace",
+                      "Window that controls how many outstanding interests are allowed",
+                      MakeTraceSourceAccessor(&PDRMConsumer::m_window),
+                      "ns3::ndn::PDRMConsumer::WindowTraceCallback")
+
+      .AddTraceSource("InFlight",
+                      "Current number of outstanding interests",
+                      MakeTraceSourceAccessor(&PDRMConsumer::m_inFlight),
+                      "ns3::ndn::PDRMConsumer::WindowTraceCallback");
 
   return tid;
 }
 
 PDRMConsumer::PDRMConsumer()
   : m_rand(CreateObject<UniformRandomVariable>())
+  , m_rtt(CreateObject<RttMeanDeviation>())
+  , m_windowBlocked(false)
+  , m_window(0)
+  , m_inFlight(0)
 {
+  m_retxTimer.SetCallback(std::bind(&PDRMConsumer::OnTimeouts, this, std::placeholders::_1));
 }
 
 /**
@@ -144,6 +166,9 @@ PDRMConsumer::StartApplication()
   m_warmup = true;
   m_execution = false;
 
+  m_retxTimer.SetTimeout(m_interestLifeTime);
+  CreateCongestionWindow();
+
   m_requestPeriod = CreateObject<ConstantRandomVariable>();
   m_requestPeriod->SetAttribute("Constant", DoubleValue(1.0 / m_lambdaRequests));
 
@@ -163,28 +188,86 @@ void
 PDRMConsumer::StopApplication()
 {
   Simulator::Cancel(m_sendEvent);
+  m_retxTimer.Cancel();
   App::StopApplication();
 }
 
+void
+PDRMConsumer::CreateCongestionWindow()
+{
+  ObjectFactory factory(m_congestionWindowType);
+  m_congestionWindow = factory.Create<PDRMCongestionWindow>();
+  m_windowBlocked = false;
+  m_window = m_congestionWindow->GetWindow();
+}
+
+bool
+PDRMConsumer::CanSendInterest()
+{
+  m_inFlight = m_downloads.getPendingCount();
+  if (m_inFlight < m_congestionWindow->GetWindow())
+    return true;
+
+  m_windowBlocked = true;
+  return false;
+}
+
+void
+PDRMConsumer::UpdateWindowOnData(uint32_t id, uint32_t seqNumber)
+{
+  const PDRMDownloadState::Chunk& record = m_downloads.getChunk(id, seqNumber);
+
+  // only chunks requested once give unambiguous RTT samples
+  if (record.requestCount == 1)
+    m_rtt->Measurement(Simulator::Now() - record.lastRequest);
+
+  m_congestionWindow->OnData(m_rtt->GetCurrentEstimate());
+  m_window = m_congestionWindow->GetWindow();
+}
+
+void
+PDRMConsumer::UpdateWindowOnTimeout()
+{
+  m_congestionWindow->OnTimeout(m_rtt->GetCurrentEstimate());
+  m_window = m_congestionWindow->GetWindow();
+}
+
+void
+PDRMConsumer::ResumeSending()
+{
+  m_inFlight = m_downloads.getPendingCount();
+  if (m_windowBlocked && m_inFlight < m_congestionWindow->GetWindow()) {
+    m_windowBlocked = false;
+    ScheduleNextPacket();
+  }
+}
+
 void
 PDRMConsumer::EndGame()
 {
-  Name chunk;
-  Name object;
-  uint32_t seqNumber;
+  // objects and their chunks are reported in name order
+  vector<uint32_t> objects = m_downloads.getObjectIds();
 
-  for (map<Name, Time>::iterator it = m_chunkFirstRequest.begin(); it != m_chunkFirstRequest.end(); ++it)
+  for (uint32_t id : objects)
   {
-    chunk = it->first;
-    seqNumber = chunk.at(-1).toSequenceNumber();
-    m_chunkFailedDelay(this, chunk, seqNumber, Simulator::Now() - m_chunkFirstRequest[chunk],
-      Simulator::Now() - m_chunkLastRequest[chunk], m_chunkRequestCount[chunk], m_maxHopCount);
+    const PDRMDownloadState::Object& object = m_downloads.getObject(id);
+    for (uint32_t seqNumber = 0; seqNumber < object.size; seqNumber++)
+    {
+      if (!m_downloads.isPending(id, seqNumber))
+        continue;
+
+      const PDRMDownloadState::Chunk& record = object.chunks[seqNumber];
+      Name chunk(object.name);
+      chunk.appendSequenceNumber(seqNumber);
+      m_chunkFailedDelay(this, chunk, seqNumber, Simulator::Now() - record.firstRequest,
+        Simulator::Now() - record.lastRequest, record.requestCount, m_maxHopCount);
+    }
   }
   
-  for (map<Name, Time>::iterator it = m_objectStartDownloadTime.begin(); it != m_objectStartDownloadTime.end(); ++it)
+  for (uint32_t id : objects)
   {
-    object = it->first;
-    m_objectFailedDownload(this, object, Simulator::Now() - m_objectStartDownloadTime[object], m_objectRequests[object]);
+    const PDRMDownloadState::Object& object = m_downloads.getObject(id);
+    m_objectFailedDownload(this, object.name, Simulator::Now() - object.startTime, object.requests);
   }
 }
 
@@ -197,13 +280,11 @@ PDRMConsumer::WarmUp()
     return;
   }
 
-  ContentObject object;
   shared_ptr<Name> interestName;
 
-  if (m_localConsumer)
-    object = m_catalog->getLocalityObjectRequest(m_position);
-  else
-    object = m_catalog->getObjectRequest();
+  const ContentObject& object = m_localConsumer ?
+                                  m_catalog->getLocalityObjectRequest(m_position) :
+                                  m_catalog->getObjectRequest();
 
   NS_LOG_INFO(object.name << " " << object.locality << " @ " << m_position);
 
@@ -233,16 +314,25 @@ PDRMConsumer::OnTimeout(Name chunk)
 {
   if (m_warmup) return;
 
-  if (m_retxEvent.count(chunk) == 0)
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
+  if (id == PDRMDownloadState::INVALID_ID || !m_downloads.isPending(id, seqNumber))
     return;
 
-  Name object = chunk.getPrefix(2);
   NS_LOG_FUNCTION(chunk);
 
-  m_objectTimeouts[object]++;
+  m_downloads.getObject(id).timeouts++;
+  UpdateWindowOnTimeout();
   SendPacket(chunk, true); 
 }
 
+void
+PDRMConsumer::OnTimeouts(const vector<Name>& chunks)
+{
+  for (const Name& chunk : chunks)
+    OnTimeout(chunk);
+}
+
 /**
  * 
  */
@@ -253,11 +343,11 @@ PDRMConsumer::OnData(shared_ptr<const Data> data)
 
   App::OnData(data);
 
-  Name chunk = data->getName();
-  Name object = chunk.getPrefix(2);
-  uint32_t seqNumber = chunk.at(-1).toSequenceNumber();
+  const Name& chunk = data->getName();
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
  
-  if (m_chunksMap[object][seqNumber])
+  if (id == PDRMDownloadState::INVALID_ID || m_downloads.isReceived(id, seqNumber))
     return;
   NS_LOG_FUNCTION_NOARGS();
 
@@ -265,30 +355,21 @@ PDRMConsumer::OnData(shared_ptr<const Data> data)
   uint32_t hopCount = 0;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { 
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-    }
+    hopCount = ns3PacketTag->getHopCount();
   }
   m_maxHopCount = max(m_maxHopCount, hopCount);
 
-  m_chunkRetrievalDelay(this, chunk, seqNumber, Simulator::Now() - m_chunkFirstRequest[chunk],
-    Simulator::Now() - m_chunkLastRequest[chunk], m_chunkRequestCount[chunk], hopCount);
-
-  m_chunkFirstRequest.erase(chunk);
-  m_chunkLastRequest.erase(chunk);
-  m_chunkRequestCount.erase(chunk);
+  const PDRMDownloadState::Chunk& record = m_downloads.getChunk(id, seqNumber);
+  m_chunkRetrievalDelay(this, chunk, seqNumber, Simulator::Now() - record.firstRequest,
+    Simulator::Now() - record.lastRequest, record.requestCount, hopCount);
 
-  Simulator::Remove(m_retxEvent[chunk]);
-  m_retxEvent.erase(chunk);
+  m_retxTimer.Remove(chunk);
+  UpdateWindowOnData(id, seqNumber);
 
-  //NS_LOG_INFO(object << " " << seqNumber << " " << m_chunksMap[object][seqNumber] << " " << m_chunksDownloaded[object]);
+  if (m_downloads.markReceived(id, seqNumber))
+    ConcludeObjectDownload(m_downloads.getObject(id).name);
 
-  m_chunksMap[object][seqNumber] = true;
-  m_chunksDownloaded[object]++;
-
-  if (m_chunksDownloaded[object] == m_objectSize[object])
-    ConcludeObjectDownload(object);
+  ResumeSending();
 }
 
 /**
@@ -302,17 +383,17 @@ PDRMConsumer::FindObject()
     return;
   }
 
-  ContentObject object;
+  const ContentObject* object = nullptr;
   NS_LOG_FUNCTION_NOARGS();
 
   do {
     if (m_localConsumer)
-      object = m_catalog->getLocalityObjectRequest(m_position);
+      object = &m_catalog->getLocalityObjectRequest(m_position);
     else
-      object = m_catalog->getObjectRequest();
-  } while (m_objectStartDownloadTime.count(object.name) > 0);
-  NS_LOG_INFO(object.name);
-  StartObjectDownload(object);
+      object = &m_catalog->getObjectRequest();
+  } while (m_downloads.isDownloading(object->name));
+  NS_LOG_INFO(object->name);
+  StartObjectDownload(*object);
 }
 
 /**
@@ -321,33 +402,25 @@ PDRMConsumer::FindObject()
 void
 PDRMConsumer::FoundObject(Name interestingObject)
 {
-  ContentObject object = m_catalog->getObject(interestingObject);
-  StartObjectDownload(object);
+  StartObjectDownload(m_catalog->getObject(interestingObject));
 }
 
 /**
  * 
  */
 void
-PDRMConsumer::StartObjectDownload(ContentObject object)
+PDRMConsumer::StartObjectDownload(const ContentObject& object)
 {
-  shared_ptr<Name> interestName;
-
   // For each chunk, append the sequence number and add it to the interest queue
   for (uint32_t i = 0; i < object.size; i++) {
-    interestName = make_shared<Name>(object.name);
-    interestName->appendSequenceNumber(i);
-    m_chunkRequest.push(*interestName);
+    Name interestName = object.name;
+    interestName.appendSequenceNumber(i);
+    m_chunkRequest.push(interestName);
   }
 
   NS_LOG_INFO(object.name << " " << object.locality << " @ " << m_position);
 
-  m_objectStartDownloadTime[object.name] = Simulator::Now();
-  m_objectSize[object.name] = object.size;
-  m_objectRequests[object.name] = 0;
-  m_objectTimeouts[object.name] = 0;
-  m_chunksMap[object.name] = map<uint32_t, bool>();
-  m_chunksDownloaded[object.name] = 0;
+  m_downloads.startObject(object.name, object.size);
 
   ScheduleNextPacket();
 }
@@ -375,6 +448,9 @@ PDRMConsumer::GetNextPacket()
   Name chunk;
 
   if (m_chunkRequest.size() > 0) {
+    if (!CanSendInterest())
+      return;
+
     chunk = m_chunkRequest.front();
     m_chunkRequest.pop();
     SendPacket(chunk, false);
@@ -395,8 +471,6 @@ PDRMConsumer::SendPacket(Name chunk, bool retransmission)
     return;
   NS_LOG_FUNCTION_NOARGS();
 
-  Name object = chunk.getPrefix(2);
-
   // Create interest packet
   shared_ptr<Interest> interest = make_shared<Interest>();
   interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
@@ -409,8 +483,13 @@ PDRMConsumer::SendPacket(Name chunk, bool retransmission)
   m_transmittedInterests(interest, this, m_face);
   m_face->onReceiveInterest(*interest);
 
-  m_objectRequests[object]++;
-  m_retxEvent[chunk] = Simulator::Schedule(m_interestLifeTime, &PDRMConsumer::OnTimeout, this, chunk);
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
+  if (id != PDRMDownloadState::INVALID_ID) {
+    m_downloads.getObject(id).requests++;
+    m_retxTimer.Add(chunk);
+  }
+  m_inFlight = m_downloads.getPendingCount();
 
   if (!retransmission)
     ScheduleNextPacket();
@@ -422,14 +501,10 @@ PDRMConsumer::SendPacket(Name chunk, bool retransmission)
 void
 PDRMConsumer::WillSendOutInterest(Name chunk)
 {
-  if (m_chunkFirstRequest.count(chunk) == 0)
-  {
-    m_chunkFirstRequest[chunk] = Simulator::Now();
-    m_chunkRequestCount[chunk] = 0;
-  }
-
-  m_chunkLastRequest[chunk] = Simulator::Now();
-  m_chunkRequestCount[chunk]++;
+  uint32_t seqNumber;
+  uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
+  if (id != PDRMDownloadState::INVALID_ID)
+    m_downloads.recordRequest(id, seqNumber);
 }
 
 /**
@@ -438,16 +513,19 @@ PDRMConsumer::WillSendOutInterest(Name chunk)
 void
 PDRMConsumer::ConcludeObjectDownload(Name object)
 {
-  m_objectDownloadTime(this, object, Simulator::Now() - m_objectStartDownloadTime[object], m_objectRequests[object]);
+  uint32_t id = m_downloads.getObjectId(object);
+  if (id == PDRMDownloadState::INVALID_ID) {
+    // not downloaded by this application (e.g., stored upon a custodian hint)
+    m_objectDownloadTime(this, object, Simulator::Now(), 0);
+    return;
+  }
+
+  const PDRMDownloadState::Object& entry = m_downloads.getObject(id);
+  m_objectDownloadTime(this, object, Simulator::Now() - entry.startTime, entry.requests);
 
   NS_LOG_INFO(object);
 
-  m_objectStartDownloadTime.erase(object);
-  m_objectSize.erase(object);
-  m_objectRequests.erase(object);
-  m_objectTimeouts.erase(object);
-  m_chunksMap.erase(object);
-  m_chunksDownloaded.erase(object);
+  m_downloads.concludeObject(id);
 }
 
 } // namespace ndn
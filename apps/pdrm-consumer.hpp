@@ -25,8 +25,12 @@
 #include "ndn-app.hpp"
 
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
+#include "ns3/ndnSIM/utils/ndn-retx-timer.hpp"
+#include "ns3/traced-value.h"
 
 #include <utils/pdrm-catalog.hpp>
+#include <utils/pdrm-congestion-window.hpp>
+#include <utils/pdrm-download-state.hpp>
 #include <utils/pdrm-global.hpp>
 
 using namespace std;
@@ -57,6 +61,9 @@ public:
   virtual void
   OnTimeout(Name chunk);
 
+  void
+  OnTimeouts(const vector<Name>& chunks);
+
   virtual void
   OnData(shared_ptr<const Data> contentObject);
 
@@ -67,7 +74,7 @@ public:
   FoundObject(Name object);
 
   virtual void
-  StartObjectDownload(ContentObject object);
+  StartObjectDownload(const ContentObject& object);
 
   virtual void
   ScheduleNextPacket();
@@ -84,6 +91,7 @@ public:
   virtual void
   ConcludeObjectDownload(Name object);
 
+  typedef void (*WindowTraceCallback)(uint32_t);
   typedef void (*ChunkRetrievalDelayCallback)(Ptr<App> app, Name chunk, uint32_t order, Time totalDelay, Time lastDelay, uint32_t requestCount, uint32_t hopCount);
   typedef void (*ObjectDownloadTimeCallback)(Ptr<App> app, Name object, Time download, uint32_t requests);
   typedef void (*ChunkFailedDelayCallback)(Ptr<App> app, Name chunk, uint32_t order, Time totalDelay, Time lastDelay, uint32_t requestCount, uint32_t hopCount);
@@ -97,6 +105,37 @@ protected:
   virtual void
   StopApplication();
 
+  /**
+   * @brief Create congestion window of the type set by the CongestionWindow attribute
+   */
+  void
+  CreateCongestionWindow();
+
+  /**
+   * @brief Check whether the congestion window allows another Interest in flight
+   *
+   * If not, sending is resumed (ScheduleNextPacket) once a chunk is retrieved or times out.
+   */
+  bool
+  CanSendInterest();
+
+  /**
+   * @brief Update RTT estimation and congestion window for a retrieved chunk
+   *
+   * Must be called before the chunk is marked as received.
+   */
+  void
+  UpdateWindowOnData(uint32_t id, uint32_t seqNumber);
+
+  void
+  UpdateWindowOnTimeout();
+
+  /**
+   * @brief Resume sending if it was blocked by the congestion window and there is room now
+   */
+  void
+  ResumeSending();
+
 protected:
   Time m_warmupPeriod;
   Time m_start;
@@ -111,8 +150,16 @@ protected:
 
   queue<Name> m_chunkRequest;        // queue of chunks to request
 
-  // retransmission data structures
-  map<Name, EventId> m_retxEvent;      // retransmission event per chunk
+  // retransmission timer (expires after the Interest lifetime)
+  RetxTimer<Name, NameHash> m_retxTimer;
+
+  // congestion control
+  string m_congestionWindowType;
+  Ptr<PDRMCongestionWindow> m_congestionWindow;
+  Ptr<RttEstimator> m_rtt;
+  bool m_windowBlocked;
+  TracedValue<uint32_t> m_window;
+  TracedValue<uint32_t> m_inFlight;
 
   // Content catalog (global structure)
   Ptr<PDRMCatalog> m_catalog;
@@ -125,20 +172,10 @@ protected:
   bool m_localConsumer; // locality
   uint32_t m_position;
 
-  // chunk tracing data structures
-  map<Name, Time> m_chunkFirstRequest;
-  map<Name, Time> m_chunkLastRequest;
-  map<Name, uint32_t> m_chunkRequestCount;
+  // chunk and object tracing data structures
+  PDRMDownloadState m_downloads;
   uint32_t m_maxHopCount;
 
-  // object tracing data structures
-  map<Name, Time> m_objectStartDownloadTime;
-  map<Name, uint32_t> m_objectSize;
-  map<Name, uint32_t> m_objectRequests;
-  map<Name, uint32_t> m_objectTimeouts;
-  map<Name, map<uint32_t, bool> > m_chunksMap;
-  map<Name, uint32_t> m_chunksDownloaded;
-
   // Tracers
   // Application, chunk name, chunk order, total delay, last request delay, request count, hop count
   // if retx count == 1; total delay = last delay
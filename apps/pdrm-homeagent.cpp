@@ -30,6 +30,7 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-route-update-scheduler.hpp"
 
 #include <memory>
 
@@ -73,6 +74,13 @@ PDRMHomeAgent::GetTypeId(void)
                     MakeTimeAccessor(&PDRMHomeAgent::m_interestLifeTime),
                     MakeTimeChecker())
 
+      .AddAttribute("PacingInterval",
+                    "Interval between Interests sent on behalf of an unregistered producer "
+                    "(0 sends all of them at once)",
+                    StringValue("0s"),
+                    MakeTimeAccessor(&PDRMHomeAgent::m_pacingInterval),
+                    MakeTimeChecker())
+
       // Global
       .AddAttribute("Catalog",
                     "Content catalog",
@@ -209,8 +217,7 @@ PDRMHomeAgent::Register(Name producerPrefix)
   ndnGlobalRoutingHelper.AddOrigin(producerPrefix.toUri(), this->GetNode());
 
   FibHelper::AddRoute(GetNode(), producerPrefix, m_face, 0);
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  RouteUpdateScheduler::Get()->RequestUpdate(producerPrefix);
 
   m_unavailableProducers.insert(producerPrefix);
 }
@@ -225,33 +232,59 @@ PDRMHomeAgent::Unregister(Name producerPrefix)
   ndnGlobalRoutingHelper.RemoveOrigin(producerPrefix.toUri(), GetNode());
 
   FibHelper::RemoveRoute(GetNode(), producerPrefix, m_face);
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
 
-  for (uint32_t i = 0; i < m_storedObjects[producerPrefix].size(); i++)
+  // stored objects are requested from the producer once routes towards it are in place
+  RouteUpdateScheduler::Get()->RequestUpdate(producerPrefix,
+                                             std::bind(&PDRMHomeAgent::RequestStoredObjects, this,
+                                                       m_storedObjects[producerPrefix]));
+
+  m_storedObjects.erase(producerPrefix);
+  m_unavailableProducers.erase(producerPrefix);
+  m_retxEvent.erase(producerPrefix);
+}
+
+void
+PDRMHomeAgent::RequestStoredObjects(vector<Name> objects)
+{
+  if (!m_active)
+    return;
+
+  Time delay = Seconds(0);
+  for (uint32_t i = 0; i < objects.size(); i++)
   {
-    ContentObject object = m_catalog->getObject(m_storedObjects[producerPrefix][i]);
+    const ContentObject& object = m_catalog->getObject(objects[i]);
 
     for (uint32_t j = 0; j < object.size; j++) {
-      shared_ptr<Interest> interest = make_shared<Interest>();
-      interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
-
       Name interestName = object.name;
       interestName.appendSequenceNumber(j);
-      interest->setName(interestName);
-      interest->setInterestLifetime((time::milliseconds) m_interestLifeTime.GetMilliSeconds());
 
-      m_transmittedInterests(interest, this, m_face);
-      m_face->onReceiveInterest(*interest);
+      if (m_pacingInterval.IsZero()) {
+        SendInterest(interestName);
+      }
+      else {
+        Simulator::Schedule(delay, &PDRMHomeAgent::SendInterest, this, interestName);
+        delay += m_pacingInterval;
+      }
     }
 
     m_interceptedInterest(this, object.name, false, false, true);
-    NS_LOG_INFO(m_storedObjects[producerPrefix][i]);
+    NS_LOG_INFO(objects[i]);
   }
+}
 
-  m_storedObjects.erase(producerPrefix);
-  m_unavailableProducers.erase(producerPrefix);
-  m_retxEvent.erase(producerPrefix);
+void
+PDRMHomeAgent::SendInterest(Name chunk)
+{
+  if (!m_active)
+    return;
+
+  shared_ptr<Interest> interest = make_shared<Interest>();
+  interest->setNonce(m_rand->GetValue(0, std::numeric_limits<uint32_t>::max()));
+  interest->setName(chunk);
+  interest->setInterestLifetime((time::milliseconds) m_interestLifeTime.GetMilliSeconds());
+
+  m_transmittedInterests(interest, this, m_face);
+  m_face->onReceiveInterest(*interest);
 }
 
 } // namespace ndn
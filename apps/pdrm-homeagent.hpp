@@ -57,6 +57,15 @@ public:
   virtual void
   Unregister(Name producerPrefix);
 
+  void
+  SendInterest(Name chunk);
+
+  /**
+   * @brief Request the chunks of objects stored on behalf of a returning producer
+   */
+  void
+  RequestStoredObjects(vector<Name> objects);
+
   typedef void (*AnnouncedPrefixCallback)(Ptr<App> app, Name prefix, bool isAnnouncing);
   typedef void (*InterceptedInterestCallback)(Ptr<App> app, Name object, bool isStored, bool isTimeout, bool isSent);
 
@@ -78,6 +87,7 @@ protected:
   map<Name, map<Name, EventId> > m_retxEvent;
   Ptr<UniformRandomVariable> m_rand; // nonce generator
   Time m_interestLifeTime;
+  Time m_pacingInterval;
 
   Ptr<PDRMCatalog> m_catalog;
   Ptr<PDRMGlobal> m_global;
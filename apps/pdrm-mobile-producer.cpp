@@ -24,6 +24,7 @@
 
 #include "helper/ndn-link-control-helper.hpp"
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-route-update-scheduler.hpp"
 
 using namespace std;
 
@@ -137,8 +138,7 @@ PDRMMobileProducer::Move(Ptr<const MobilityModel> model)
   m_timeSpent[m_position.x] += lastSession;
 
   ndn::LinkControlHelper::FailLink(this->GetNode(), m_global->getRouter(m_position.x));
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  RouteUpdateScheduler::Get()->RequestUpdate();
 
   m_lastMobilityEvent = Simulator::Now();
   m_userAvailability = m_sessionPeriod.GetSeconds() / (m_sessionPeriod.GetSeconds() + m_movementPeriod.GetSeconds() + 0.001);
@@ -158,8 +158,7 @@ PDRMMobileProducer::Session(Ptr<const MobilityModel> model)
 
   m_position = model->GetPosition();
   ndn::LinkControlHelper::UpLink(this->GetNode(), m_global->getRouter(m_position.x));
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  RouteUpdateScheduler::Get()->RequestUpdate();
 
   m_lastMobilityEvent = Simulator::Now();
   m_userAvailability = m_sessionPeriod.GetSeconds() / (m_sessionPeriod.GetSeconds() + m_movementPeriod.GetSeconds() + 0.001);
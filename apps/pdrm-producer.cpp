@@ -149,7 +149,7 @@ PDRMProducer::PopulateCatalog(uint32_t index)
   //generate content
   m_catalog->addObject(*object, index);
 
-  ContentObject co = m_catalog->getObject(*object);
+  const ContentObject& co = m_catalog->getObject(*object);
   uint32_t popularity = m_catalog->getObjectPopularity(*object);
   m_producedObject(this, *object, co.size, co.availability, popularity);
 }
@@ -180,7 +180,7 @@ PDRMProducer::ProduceObject()
   //generate content
   m_catalog->addObject(*object);
 
-  ContentObject co = m_catalog->getObject(*object);
+  const ContentObject& co = m_catalog->getObject(*object);
   uint32_t popularity = m_catalog->getObjectPopularity(*object);
   m_producedObject(this, *object, co.size, co.availability, popularity);
   NS_LOG_FUNCTION_NOARGS();
@@ -24,6 +24,7 @@
 
 #include "helper/ndn-fib-helper.hpp"
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-route-update-scheduler.hpp"
 
 using namespace std;
 
@@ -78,6 +79,7 @@ PDRMProvider::GetTypeId(void)
 }
 
 PDRMProvider::PDRMProvider()
+  : m_signature(0)
 {
 }
 
@@ -93,6 +95,8 @@ PDRMProvider::StartApplication()
   m_storedObjects = 0;
   m_circularIndex = 0;
 
+  m_dataTemplate = PDRMDataTemplate(m_virtualPayloadSize, m_freshness, m_signature, m_keyLocator);
+
   Simulator::Schedule(m_global->getMaxSimulationTime() - Time("1ms"), &PDRMProvider::EndGame, this);
 }
 
@@ -129,30 +133,12 @@ PDRMProvider::OnInterest(shared_ptr<const Interest> interest)
 //  NS_LOG_INFO(interest->getName());
   
   // Create data packet
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-  // Add signature
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-  
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-  
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-  
-  data->setSignature(signature);
-  
+  auto data = m_dataTemplate.create(dataName);
+
   // logging and stats
   m_servedData(this, interest->getName());
   
   // Send it
-  data->wireEncode();
-  
   m_transmittedDatas(data, this, m_face);
   m_face->onReceiveData(*data);
 }
@@ -172,11 +158,8 @@ PDRMProvider::AnnouncePrefix(Name prefix)
 
   FibHelper::AddRoute(GetNode(), prefix, m_face, 0);
 
-  if (m_updateNetwork.IsRunning()) {
-    Simulator::Remove(m_updateNetwork);
-  }
   if (!(Simulator::Now() < Time("0.1s") && GetNode()->GetId() > 17))
-    m_updateNetwork = Simulator::Schedule(Time("50ms"), &PDRMProvider::UpdateNetwork, this);
+    UpdateNetwork(prefix);
 }
 
 void
@@ -191,19 +174,16 @@ PDRMProvider::UnannouncePrefix(Name prefix)
 
   FibHelper::RemoveRoute(GetNode(), prefix, m_face);
 
-  if (m_updateNetwork.IsRunning()) {
-    Simulator::Remove(m_updateNetwork);
-  }
-  m_updateNetwork = Simulator::Schedule(Time("50ms"), &PDRMProvider::UpdateNetwork, this);
+  UpdateNetwork(prefix);
 }
 
 void
-PDRMProvider::UpdateNetwork()
+PDRMProvider::UpdateNetwork(Name prefix)
 {
   NS_LOG_FUNCTION_NOARGS();
 
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  // coalesced with the route updates requested by all other applications
+  RouteUpdateScheduler::Get()->RequestUpdate(prefix);
 }
 
 void
@@ -25,6 +25,8 @@
 
 #include "pdrm-consumer.hpp"
 
+#include <utils/pdrm-data-template.hpp>
+
 using namespace std;
 
 namespace ns3 {
@@ -56,7 +58,7 @@ public:
   UnannouncePrefix(Name prefix);
 
   virtual void
-  UpdateNetwork();
+  UpdateNetwork(Name prefix);
 
   virtual void
   StoreObject(Name object);
@@ -77,7 +79,6 @@ protected:
 
 protected:
   set<Name> m_announcedPrefixes;
-  EventId m_updateNetwork;
 
   uint32_t m_virtualPayloadSize;
   Time m_freshness;
@@ -92,6 +93,9 @@ protected:
   uint32_t m_signature;
   Name m_keyLocator;
 
+  // Encoded once in StartApplication and shared by every served chunk
+  PDRMDataTemplate m_dataTemplate;
+
   TracedCallback<Ptr<App>, Name> m_servedData;
   TracedCallback<Ptr<App>, Name, bool> m_announcedPrefix;
 };
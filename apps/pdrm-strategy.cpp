@@ -165,7 +165,7 @@ PDRMStrategy::PopulateCatalog(uint32_t index)
   //generate content
   m_catalog->addObject(*object, index);
 
-  ContentObject co = m_catalog->getObject(*object);
+  const ContentObject& co = m_catalog->getObject(*object);
   uint32_t popularity = m_catalog->getObjectPopularity(*object);
   m_producedObject(this, *object, co.size, co.availability, popularity);
 
@@ -258,17 +258,7 @@ PDRMStrategy::OnVicinity(shared_ptr<const Interest> interest)
   vicinityData->setContent(responseSelectors.wireEncode());
 
   // Add signature
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  vicinityData->setSignature(signature);
+  vicinityData->setSignature(m_dataTemplate.getSignature());
 
   // Send the packet
   vicinityData->wireEncode();
@@ -291,36 +281,31 @@ PDRMStrategy::OnData(shared_ptr<const Data> data)
   }
   else
   {
-    Name chunk = data->getName();
-    Name object = chunk.getPrefix(2);
-    uint32_t seqNumber = chunk.at(-1).toSequenceNumber();
+    const Name& chunk = data->getName();
+    uint32_t seqNumber;
+    uint32_t id = m_downloads.getChunkId(chunk, seqNumber);
 
-    if (m_chunksMap[object][seqNumber])
+    if (id == PDRMDownloadState::INVALID_ID || m_downloads.isReceived(id, seqNumber))
       return;
 
     // Calculate the hop count
     int hopCount = 0;
     auto ns3PacketTag = data->getTag<Ns3PacketTag>();
     if (ns3PacketTag != nullptr) {
-      FwHopCountTag hopCountTag;
-      if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-        hopCount = hopCountTag.Get();
-      }
+      hopCount = ns3PacketTag->getHopCount();
     }
 
-    m_chunkRetrievalDelay(this, chunk, seqNumber, Simulator::Now() - m_chunkFirstRequest[chunk],
-      Simulator::Now() - m_chunkLastRequest[chunk], m_chunkRequestCount[chunk], hopCount);
+    const PDRMDownloadState::Chunk& record = m_downloads.getChunk(id, seqNumber);
+    m_chunkRetrievalDelay(this, chunk, seqNumber, Simulator::Now() - record.firstRequest,
+      Simulator::Now() - record.lastRequest, record.requestCount, hopCount);
 
-    m_chunkFirstRequest.erase(chunk);
-    m_chunkLastRequest.erase(chunk);
-    m_chunkRequestCount.erase(chunk);
-    m_retxEvent.erase(chunk);
+    m_retxTimer.Remove(chunk);
+    UpdateWindowOnData(id, seqNumber);
 
-    m_chunksMap[object][seqNumber] = true;
-    m_chunksDownloaded[object]++;
+    if (m_downloads.markReceived(id, seqNumber))
+      ConcludeObjectDownload(m_downloads.getObject(id).name);
 
-    if (m_chunksDownloaded[object] == m_objectSize[object])
-      ConcludeObjectDownload(object);
+    ResumeSending();
   }
 }
 
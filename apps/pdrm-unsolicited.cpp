@@ -28,6 +28,8 @@
 #include "helper/ndn-link-control-helper.hpp"
 #include "helper/ndn-fib-helper.hpp"
 
+#include <algorithm>
+
 using namespace std;
 
 NS_LOG_COMPONENT_DEFINE("ndn.PDRMUnsolicited");
@@ -59,6 +61,12 @@ PDRMUnsolicited::GetTypeId(void)
                     MakeTimeAccessor(&PDRMUnsolicited::m_idleRequest),
                     MakeTimeChecker())
 
+      .AddAttribute("PacingInterval",
+                    "Interval between pushed Data packets (0 pushes all of them at once)",
+                    StringValue("0s"),
+                    MakeTimeAccessor(&PDRMUnsolicited::m_pacingInterval),
+                    MakeTimeChecker())
+
       // Tracing
       .AddTraceSource("PushedUnsolicitedData",
                       "Data chunks pushed by the producer",
@@ -81,14 +89,27 @@ void
 PDRMUnsolicited::StartApplication() 
 {
   PDRMMobileProducer::StartApplication();
+
+  m_unsolicitedTemplate = PDRMDataTemplate(m_virtualPayloadSize, m_freshness, m_signature,
+                                           m_keyLocator, true);
 }
 
 void
 PDRMUnsolicited::StopApplication()
 {
+  CancelPacedData();
   PDRMMobileProducer::StopApplication();
 }
 
+void
+PDRMUnsolicited::CancelPacedData()
+{
+  for (uint32_t i = 0; i < m_pacedData.size(); i++)
+    Simulator::Cancel(m_pacedData[i]);
+
+  m_pacedData.clear();
+}
+
 void
 PDRMUnsolicited::EndGame()
 {
@@ -148,7 +169,7 @@ PDRMUnsolicited::OnInterest(shared_ptr<const Interest> interest)
   m_timeoutUnsolicitedData[objectPrefix] = Simulator::Schedule(m_idleRequest, &PDRMUnsolicited::OnTimeoutUnsolicitedData, this, objectPrefix);
 
   /* Check if it is still active */
-  ContentObject properties = m_catalog->getObject(objectPrefix);
+  const ContentObject& properties = m_catalog->getObject(objectPrefix);
   if (properties.size == seqNumber + 1)
   {
     for (uint32_t i = 0; i < m_activeRequests.size(); i++)
@@ -166,30 +187,12 @@ PDRMUnsolicited::OnInterest(shared_ptr<const Interest> interest)
   /* End of changes */
 
   // Create data packet
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-  
-  // Add signature
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-  
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-  
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-  
-  data->setSignature(signature);
-  
+  auto data = m_dataTemplate.create(dataName);
+
   // logging and stats
   m_servedData(this, interest->getName());
   
   // Send it
-  data->wireEncode();
-  
   m_transmittedDatas(data, this, m_face);
   m_face->onReceiveData(*data);
 }
@@ -203,11 +206,16 @@ PDRMUnsolicited::PushUnsolicitedData()
     return;
 
   shared_ptr<Name> chunk;
-  ContentObject object;
+  Time delay = Seconds(0);
+
+  // forget paced Data packets of previous pushes that have already been sent
+  m_pacedData.erase(remove_if(m_pacedData.begin(), m_pacedData.end(),
+                              [] (const EventId& event) { return event.IsExpired(); }),
+                    m_pacedData.end());
 
   for (uint32_t i = 0; i < m_activeRequests.size(); i++)
   {
-    object = m_catalog->getObject(m_activeRequests[i]);
+    const ContentObject& object = m_catalog->getObject(m_activeRequests[i]);
     if (i < m_objectsToPush) {
       m_pushedUnsolicitedObject(this, object.name, true, false);
       NS_LOG_INFO(object.name);
@@ -215,7 +223,14 @@ PDRMUnsolicited::PushUnsolicitedData()
       {
         chunk = make_shared<Name>(object.name);
         chunk->appendSequenceNumber(i);
-        SendUnsolicitedData(*chunk);
+        if (m_pacingInterval.IsZero()) {
+          SendUnsolicitedData(*chunk);
+        }
+        else {
+          m_pacedData.push_back(Simulator::Schedule(delay, &PDRMUnsolicited::SendUnsolicitedData,
+                                                    this, *chunk));
+          delay += m_pacingInterval;
+        }
       }
     } else {
       m_pushedUnsolicitedObject(this, object.name, false, false);
@@ -233,32 +248,16 @@ void
 PDRMUnsolicited::SendUnsolicitedData(Name chunk)
 {
   NS_LOG_INFO(chunk);
+  if (!m_active)
+    return;
+
   // Create data packet
-  auto data = make_shared<Data>();
-  data->setName(chunk);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-  data->setUnsolicited(true); 
- 
-  // Add signature
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-  
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-  
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-  
-  data->setSignature(signature);
-  
+  auto data = m_unsolicitedTemplate.create(chunk);
+
   // logging and stats
   m_pushedUnsolicitedData(this, data->getName());
   
   // Send it
-  data->wireEncode();
-  
   m_transmittedDatas(data, this, m_face);
   m_face->onReceiveData(*data);
 }
@@ -274,6 +273,14 @@ PDRMUnsolicited::UnsolicitedMove(Ptr<const MobilityModel> model)
   Simulator::Schedule(Time("50ms"), &PDRMUnsolicited::Move, this, model);
 }
 
+void
+PDRMUnsolicited::Move(Ptr<const MobilityModel> model)
+{
+  // pushed Data packets not sent yet would leave through the link being failed
+  CancelPacedData();
+  PDRMMobileProducer::Move(model);
+}
+
 // This is equal to PDRMMobileProducer, but the Move part is different
 void
 PDRMUnsolicited::CourseChange(Ptr<const MobilityModel> model)
@@ -64,6 +64,9 @@ public:
   virtual void
   UnsolicitedMove(Ptr<const MobilityModel> model);
 
+  virtual void
+  Move(Ptr<const MobilityModel> model);
+
   typedef void (*PushedUnsolicitedDataCallback)(Ptr<App> app, Name object);
   typedef void (*PushedUnsolicitedObjectCallback)(Ptr<App> app, Name object, bool isPushed, bool isTimeout);
 
@@ -75,6 +78,13 @@ protected:
   virtual void
   StopApplication();
 
+private:
+  /**
+   * @brief Cancel pushed Data packets that are still waiting for their pacing slot
+   */
+  void
+  CancelPacedData();
+
 private:
   // Strategy (vicinity, hint, and replication)
   uint32_t m_objectsToPush;
@@ -83,7 +93,12 @@ private:
   Name m_unsolicitedPrefix;
 
   Time m_idleRequest;
+  Time m_pacingInterval;
   map<Name, EventId> m_timeoutUnsolicitedData;
+  vector<EventId> m_pacedData;
+
+  // Same as m_dataTemplate, with the unsolicited flag already encoded
+  PDRMDataTemplate m_unsolicitedTemplate;
 
   TracedCallback<Ptr<App>, Name> m_pushedUnsolicitedData;
   TracedCallback<Ptr<App>, Name, bool, bool> m_pushedUnsolicitedObject;
@@ -30,6 +30,7 @@
 #include "model/ndn-ns3.hpp"
 #include "model/ndn-l3-protocol.hpp"
 #include "helper/ndn-fib-helper.hpp"
+#include "helper/ndn-route-update-scheduler.hpp"
 
 #include <memory>
 
@@ -132,11 +133,8 @@ ProbeAgent::OnData(shared_ptr<const Data> data)
   int hopCount = 0;
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
   if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount = hopCountTag.Get();
-      NS_LOG_DEBUG("Hop count: " << hopCount);
-    }
+    hopCount = ns3PacketTag->getHopCount();
+    NS_LOG_DEBUG("Hop count: " << hopCount);
   }
 
   string prefix = data->getName().at(0).toUri();
@@ -168,8 +166,7 @@ ProbeAgent::Register(string prefix, string locator)
   ndn::GlobalRoutingHelper ndnGlobalRoutingHelper; 
   ndnGlobalRoutingHelper.AddOrigin(prefix, GetNode());
   FibHelper::AddRoute(GetNode(), prefix, m_face, 0);
-  ndn::GlobalRoutingHelper::CalculateRoutes();
-  ndn::GlobalRoutingHelper::PrintFIBs();
+  RouteUpdateScheduler::Get()->RequestUpdate(Name(prefix));
   NS_LOG_INFO("Node" << GetNode()->GetId() << " registering " << prefix << " => " << locator);
 }
 
@@ -189,7 +186,7 @@ ProbeAgent::Unregister(string prefix)
   ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
 //  ndnGlobalRoutingHelper.RemoveOrigin(prefix, GetNode());
   FibHelper::RemoveRoute(GetNode(), prefix, m_face);
-  ndn::GlobalRoutingHelper::CalculateRoutes();
+  RouteUpdateScheduler::Get()->RequestUpdate(Name(prefix));
   NS_LOG_DEBUG("Node" << GetNode()->GetId() << " unregistering " << prefix);
 }
 
@@ -28,10 +28,12 @@
 #include "ns3/uinteger.h"
 #include "ns3/integer.h"
 #include "ns3/double.h"
+#include "ns3/pointer.h"
 
 #include "utils/ndn-ns3-packet-tag.hpp"
 #include "model/ndn-app-face.hpp"
 #include "utils/ndn-rtt-mean-deviation.hpp"
+#include "helper/ndn-hop-distance-oracle.hpp"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/ref.hpp>
@@ -67,6 +69,12 @@ ProbeConsumer::GetTypeId(void)
                     UintegerValue(100), MakeUintegerAccessor(&ProbeConsumer::m_objects),
                     MakeUintegerChecker<uint32_t>())
 
+      /* PDRM Change */
+      .AddAttribute("Routers", "Routers in the network; producer locations index into this list",
+                    PointerValue(NULL), MakePointerAccessor(&ProbeConsumer::m_routers),
+                    MakePointerChecker<Catalog>())
+      /* PDRM Change */
+
       .AddTraceSource("PathStretch",
                       "Path stretch of requests",
                       MakeTraceSourceAccessor(&ProbeConsumer::m_pathStretch),
@@ -180,16 +188,19 @@ ProbeConsumer::OnData(shared_ptr<const Data> data)
   }
 
   auto ns3PacketTag = data->getTag<Ns3PacketTag>();
-  if (ns3PacketTag != nullptr) { // e.g., packet came from local node's cache
-    FwHopCountTag hopCountTag;
-    if (ns3PacketTag->getPacket()->PeekPacketTag(hopCountTag)) {
-      hopCount += (hopCountTag.Get()-1);
-      NS_LOG_DEBUG("Hop count: " << hopCount);
-    }
+  if (ns3PacketTag != nullptr && ns3PacketTag->getHopCount() > 0) { // e.g., packet came from local node's cache
+    hopCount += (ns3PacketTag->getHopCount()-1);
+    NS_LOG_DEBUG("Hop count: " << hopCount);
   }
 
-  if (GetNode()->GetId() > prodloc) sp = GetNode()->GetId() - prodloc;
-  else sp = prodloc - GetNode()->GetId();
+  /* PDRM Change */
+  // prodloc is a position in the router list, not a node ID
+  uint32_t producerNode = prodloc;
+  if (m_routers != 0 && prodloc < m_routers->getRouters().size()) {
+    producerNode = m_routers->getRouters()[prodloc]->GetId();
+  }
+  sp = HopDistanceOracle::Get().GetDistance(producerNode, GetNode()->GetId());
+  /* PDRM Change */
   stretch = hopCount - sp;
 
   m_pathStretch(this, data->getName(), hopCount, sp, stretch, distHA_MP, data->getName().at(-2).toUri(), Simulator::Now() - m_request); 
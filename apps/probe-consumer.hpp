@@ -32,6 +32,7 @@
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/utils/ndn-rtt-estimator.hpp"
 #include "ns3/ndnSIM/utils/ndn-fw-hop-count-tag.hpp"
+#include <utils/ndn-catalog.hpp>
 
 #include <set>
 #include <map>
@@ -100,6 +101,9 @@ protected:
   uint32_t m_objects;      ///< @brief currently requested sequence number
   double m_frequency; // Frequency of interest packets (in hertz)
   Name m_interestName;     ///< \brief NDN Name of the Interest (use Name)
+  /* PDRM Change */
+  Ptr<Catalog> m_routers;  ///< @brief routers that producer locations index into
+  /* PDRM Change */
 
   TracedCallback<Ptr<App>, Name, int32_t, int32_t, int32_t, int32_t, string, Time> m_pathStretch;
 
@@ -107,6 +107,8 @@ ProbeProducer::StartApplication()
   NS_LOG_FUNCTION_NOARGS();
   App::StartApplication();
 
+  m_dataTemplate = PDRMDataTemplate(m_virtualPayloadSize, m_freshness, m_signature, m_keyLocator);
+
   Ptr<MobilityModel> mob = GetNode()->GetObject<MobilityModel>();
   mob->TraceConnectWithoutContext("CourseChange", MakeCallback(&ProbeProducer::CourseChange, this));
   m_location = m_home;
@@ -138,26 +140,7 @@ ProbeProducer::OnInterest(shared_ptr<const Interest> interest)
   Name dataName(interest->getName());
   dataName.append(to_string((int) m_location.x));
 
-  auto data = make_shared<Data>();
-  data->setName(dataName);
-  data->setFreshnessPeriod(::ndn::time::milliseconds(m_freshness.GetMilliSeconds()));
-
-  data->setContent(make_shared< ::ndn::Buffer>(m_virtualPayloadSize));
-
-  Signature signature;
-  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
-
-  if (m_keyLocator.size() > 0) {
-    signatureInfo.setKeyLocator(m_keyLocator);
-  }
-
-  signature.setInfo(signatureInfo);
-  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, m_signature));
-
-  data->setSignature(signature);
-
-  // to create real wire encoding
-  data->wireEncode();
+  auto data = m_dataTemplate.create(dataName);
 
   m_transmittedDatas(data, this, m_face);
   m_face->onReceiveData(*data);
@@ -221,7 +204,7 @@ ProbeProducer::CourseChange(Ptr<const MobilityModel> model)
 
   NS_LOG_INFO("Producer" << GetNode()->GetId() << " new position " << m_location.x);
 
-  uint32_t changes = ndn::GlobalRoutingHelper::CalculateRoutes();
+  uint32_t changes = ndn::GlobalRoutingHelper::CalculateRoutesIncremental();
   m_FIBChanges(this, m_prefix, changes);
   ndn::GlobalRoutingHelper::PrintFIBs();
 
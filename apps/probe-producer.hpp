@@ -32,6 +32,7 @@
 
 #include "helper/ndn-link-control-helper.hpp"
 #include <utils/ndn-catalog.hpp>
+#include <utils/pdrm-data-template.hpp>
 #include <vector>
 
 namespace ns3 {
@@ -88,6 +89,7 @@ protected:
 
   uint32_t m_signature;
   Name m_keyLocator;
+  PDRMDataTemplate m_dataTemplate;
 
   Ptr<Catalog> m_routers;
 
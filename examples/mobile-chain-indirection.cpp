@@ -119,6 +119,7 @@ main(int argc, char* argv[])
   consumerHelper.SetPrefix(prefix);
   consumerHelper.SetAttribute("Frequency", DoubleValue(6.0)); // 6 interests a minute
   consumerHelper.SetAttribute("Objects", UintegerValue(obj)); // 100 objects
+  consumerHelper.SetAttribute("Routers", PointerValue(catalog));
   consumerHelper.Install(consumers).Start(Seconds(2));                     
 
   ndn::AppHelper agentHelper("ns3::ndn::ProbeAgent");
@@ -114,6 +114,7 @@ main(int argc, char* argv[])
   consumerHelper.SetPrefix(prefix);
   consumerHelper.SetAttribute("Frequency", DoubleValue(6.0)); // 6 interests a minute
   consumerHelper.SetAttribute("Objects", UintegerValue(obj)); // 100 objects
+  consumerHelper.SetAttribute("Routers", PointerValue(catalog));
   consumerHelper.Install(consumers).Start(Seconds(2));                     
 
   // Producer
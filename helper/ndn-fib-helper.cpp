@@ -182,22 +182,17 @@ FibHelper::AddRoute(const std::string& nodeName, const Name& prefix,
 void
 FibHelper::RemoveRoutes(Ptr<Node> node, const Name& prefix)
 {
+  // Removing the next hops of every face leaves no FIB entry, do it directly
   Ptr<GlobalRouter> source = node->GetObject<GlobalRouter>();
-  for (auto& pr : source->GetLocalPrefixes()) {
-    //std::cout << *pr << " == " << prefix.toUri() << std::endl;
-    if (prefix.toUri() == pr->toUri())
-      return;
+  if (source == 0) {
+    node->GetObject<L3Protocol>()->removeNextHops(prefix);
+    return;
   }
 
-  // Get L3Protocol object
-  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
-  // Get the forwarder instance
-  shared_ptr<nfd::Forwarder> m_forwarder = L3protocol->getForwarder();
+  if (source->HasLocalPrefix(prefix))
+    return;
 
-  for (const auto& face : m_forwarder->getFaceTable())
-  {
-    RemoveRoute(node, prefix, face);
-  }
+  source->RemoveRoutes(prefix);
 }
 /* PDRM Change */
 
@@ -41,6 +41,10 @@ using ::ndn::nfd::ControlParameters;
  * The FIB helper interacts with the FIB manager of NFD by sending special Interest
  * commands to the manager in order to add/remove a next hop from FIB entries or add
  * routes to the FIB manually (manual configuration of FIB).
+ *
+ * Simulation-internal code that does not need to exercise the management protocol can
+ * modify the FIB directly with L3Protocol::addNextHop, L3Protocol::removeNextHop, and
+ * L3Protocol::updateFib.
  */
 class FibHelper {
 public:
@@ -102,6 +106,15 @@ public:
            int32_t metric);
 
   /* PDRM Change */
+  /**
+   * \brief remove all next hops of FIB entry, unless prefix is exported by node's GlobalRouter
+   *
+   * Next hops are removed directly through L3Protocol::removeNextHops, without issuing
+   * FIB management commands
+   *
+   * \param node Node
+   * \param prefix Routing prefix
+   */
   static void
   RemoveRoutes(Ptr<Node> node, const Name& prefix);
   /* PDRM Change */
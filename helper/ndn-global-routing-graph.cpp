@@ -0,0 +1,461 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-global-routing-graph.hpp"
+
+#include "model/ndn-net-device-face.hpp"
+
+#include "ns3/node-list.h"
+#include "ns3/channel-list.h"
+#include "ns3/node.h"
+#include "ns3/channel.h"
+#include "ns3/net-device.h"
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+
+#include <deque>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRoutingGraph");
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t GlobalRoutingGraph::INFINITE_COST;
+const uint32_t GlobalRoutingGraph::NO_VERTEX;
+
+namespace {
+
+/**
+ * @brief Indexed 4-ary min-heap of vertices keyed by path cost, with decrease-key
+ *
+ * A 4-ary heap is shallower than a binary one and keeps the children of a node in one cache
+ * line, which pays off with the frequent decrease-key operations of Dijkstra.
+ */
+class VertexHeap {
+public:
+  explicit VertexHeap(uint32_t size)
+    : m_position(size, NOT_QUEUED)
+  {
+  }
+
+  bool
+  IsEmpty() const
+  {
+    return m_heap.empty();
+  }
+
+  void
+  Update(uint32_t vertex, uint32_t cost)
+  {
+    uint32_t position = m_position[vertex];
+    if (position == NOT_QUEUED) {
+      position = m_heap.size();
+      m_heap.push_back(Entry(cost, vertex));
+    }
+    else {
+      m_heap[position].first = cost;
+    }
+    SiftUp(position);
+  }
+
+  uint32_t
+  Pop()
+  {
+    uint32_t vertex = m_heap.front().second;
+    m_position[vertex] = NOT_QUEUED;
+
+    Entry last = m_heap.back();
+    m_heap.pop_back();
+    if (!m_heap.empty()) {
+      m_heap.front() = last;
+      m_position[last.second] = 0;
+      SiftDown(0);
+    }
+    return vertex;
+  }
+
+private:
+  typedef std::pair<uint32_t, uint32_t> Entry; // path cost, vertex
+
+  static const uint32_t ARITY = 4;
+  static const uint32_t NOT_QUEUED = std::numeric_limits<uint32_t>::max();
+
+  void
+  SiftUp(uint32_t position)
+  {
+    Entry entry = m_heap[position];
+    while (position > 0) {
+      uint32_t parent = (position - 1) / ARITY;
+      if (!(entry < m_heap[parent]))
+        break;
+      Place(position, m_heap[parent]);
+      position = parent;
+    }
+    Place(position, entry);
+  }
+
+  void
+  SiftDown(uint32_t position)
+  {
+    Entry entry = m_heap[position];
+    uint32_t size = m_heap.size();
+    while (true) {
+      uint32_t first = position * ARITY + 1;
+      if (first >= size)
+        break;
+
+      uint32_t best = first;
+      uint32_t last = std::min(first + ARITY, size);
+      for (uint32_t child = first + 1; child < last; child++) {
+        if (m_heap[child] < m_heap[best])
+          best = child;
+      }
+
+      if (!(m_heap[best] < entry))
+        break;
+      Place(position, m_heap[best]);
+      position = best;
+    }
+    Place(position, entry);
+  }
+
+  void
+  Place(uint32_t position, const Entry& entry)
+  {
+    m_heap[position] = entry;
+    m_position[entry.second] = position;
+  }
+
+private:
+  std::vector<Entry> m_heap;
+  std::vector<uint32_t> m_position;
+};
+
+/**
+ * @brief Check whether a link metric marks the link as down (see LinkControlHelper::FailLink)
+ */
+bool
+IsDown(uint32_t metric)
+{
+  return metric >= GlobalRoutingGraph::INFINITE_COST - 1;
+}
+
+} // namespace
+
+GlobalRoutingGraph&
+GlobalRoutingGraph::Get()
+{
+  GlobalRoutingGraph& graph = Instance();
+
+  if (!graph.m_built || graph.m_topologyVersion != GlobalRouter::GetTopologyVersion()) {
+    graph.Build();
+  }
+  graph.UpdateMetrics();
+
+  return graph;
+}
+
+GlobalRoutingGraph&
+GlobalRoutingGraph::Instance()
+{
+  // never destroyed, Reset releases the routers and faces on Simulator::Destroy
+  static GlobalRoutingGraph* graph = new GlobalRoutingGraph();
+  return *graph;
+}
+
+GlobalRoutingGraph::GlobalRoutingGraph()
+  : m_topologyVersion(0)
+  , m_built(false)
+  , m_linkStateVersion(0)
+{
+}
+
+void
+GlobalRoutingGraph::Reset()
+{
+  Instance() = GlobalRoutingGraph();
+}
+
+uint32_t
+GlobalRoutingGraph::GetLinkStateVersion() const
+{
+  return m_linkStateVersion;
+}
+
+uint32_t
+GlobalRoutingGraph::GetSize() const
+{
+  return m_routers.size();
+}
+
+Ptr<GlobalRouter>
+GlobalRoutingGraph::GetRouter(uint32_t id) const
+{
+  if (id >= m_routers.size())
+    return 0;
+  return m_routers[id];
+}
+
+const std::vector<Ptr<GlobalRouter>>&
+GlobalRoutingGraph::GetRouters() const
+{
+  return m_routers;
+}
+
+void
+GlobalRoutingGraph::GetAdjacencies(uint32_t vertex, std::vector<Adjacency>& adjacencies) const
+{
+  adjacencies.clear();
+  if (vertex >= m_routers.size())
+    return;
+
+  for (uint32_t i = m_outOffsets[vertex]; i < m_outOffsets[vertex + 1]; i++) {
+    if (m_faces[i] == nullptr)
+      continue; // vertex is a channel itself
+
+    uint32_t target = m_outTargets[i];
+    bool isChannel = m_outOffsets[target] < m_outOffsets[target + 1]
+                     && m_faces[m_outOffsets[target]] == nullptr;
+    if (!isChannel) {
+      adjacencies.push_back(Adjacency{m_faces[i], target, m_metrics[i]});
+      continue;
+    }
+
+    for (uint32_t j = m_outOffsets[target]; j < m_outOffsets[target + 1]; j++) {
+      if (m_outTargets[j] != vertex)
+        adjacencies.push_back(Adjacency{m_faces[i], m_outTargets[j],
+                                        static_cast<uint32_t>(m_metrics[i] + m_metrics[j])});
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::Build()
+{
+  NS_LOG_DEBUG("Building routing graph, topology version " << GlobalRouter::GetTopologyVersion());
+
+  if (!m_built)
+    Simulator::ScheduleDestroy(&GlobalRoutingGraph::Reset);
+
+  m_topologyVersion = GlobalRouter::GetTopologyVersion();
+  m_built = true;
+  m_linkStateVersion++;
+  m_routers.clear();
+
+  auto addRouter = [this] (Ptr<GlobalRouter> router) {
+    if (router->GetId() >= m_routers.size())
+      m_routers.resize(router->GetId() + 1);
+    m_routers[router->GetId()] = router;
+  };
+
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> router = (*node)->GetObject<GlobalRouter>();
+    if (router != 0)
+      addRouter(router);
+  }
+  for (ChannelList::Iterator channel = ChannelList::Begin(); channel != ChannelList::End();
+       channel++) {
+    Ptr<GlobalRouter> router = (*channel)->GetObject<GlobalRouter>();
+    if (router != 0)
+      addRouter(router);
+  }
+  // incidencies may lead to routers that are neither on a node nor on a channel
+  for (uint32_t id = 0; id < m_routers.size(); id++) {
+    if (m_routers[id] == 0)
+      continue;
+    for (const auto& edge : m_routers[id]->GetIncidencies()) {
+      if (std::get<2>(edge)->GetId() >= m_routers.size() || m_routers[std::get<2>(edge)->GetId()] == 0)
+        addRouter(std::get<2>(edge));
+    }
+  }
+
+  uint32_t size = m_routers.size();
+
+  m_outOffsets.assign(size + 1, 0);
+  m_outTargets.clear();
+  m_faces.clear();
+  std::vector<uint32_t> inDegree(size, 0);
+
+  for (uint32_t id = 0; id < size; id++) {
+    m_outOffsets[id] = m_outTargets.size();
+    if (m_routers[id] == 0)
+      continue;
+
+    for (const auto& edge : m_routers[id]->GetIncidencies()) {
+      uint32_t target = std::get<2>(edge)->GetId();
+      m_outTargets.push_back(target);
+      m_faces.push_back(std::get<1>(edge));
+      inDegree[target]++;
+    }
+  }
+  m_outOffsets[size] = m_outTargets.size();
+  m_metrics.assign(m_outTargets.size(), 0);
+
+  // propagation delay of the link behind every face (e.g., PointToPointChannel "Delay"); edges
+  // leaving channel vertices add nothing, so a multi-access link is counted once
+  m_delays.assign(m_outTargets.size(), 0.0);
+  for (size_t edge = 0; edge < m_faces.size(); edge++) {
+    auto face = dynamic_pointer_cast<NetDeviceFace>(m_faces[edge]);
+    if (face == nullptr)
+      continue;
+
+    Ptr<Channel> channel = face->GetNetDevice()->GetChannel();
+    TimeValue delay;
+    if (channel != 0 && channel->GetAttributeFailSafe("Delay", delay))
+      m_delays[edge] = delay.Get().ToDouble(Time::S);
+  }
+
+  // counting sort of the edges by target
+  m_inOffsets.assign(size + 1, 0);
+  for (uint32_t id = 0; id < size; id++) {
+    m_inOffsets[id + 1] = m_inOffsets[id] + inDegree[id];
+  }
+  m_inSources.assign(m_outTargets.size(), 0);
+  m_inEdges.assign(m_outTargets.size(), 0);
+  std::vector<uint32_t> next(m_inOffsets.begin(), m_inOffsets.end() - 1);
+  for (uint32_t id = 0; id < size; id++) {
+    for (uint32_t edge = m_outOffsets[id]; edge < m_outOffsets[id + 1]; edge++) {
+      uint32_t slot = next[m_outTargets[edge]]++;
+      m_inSources[slot] = id;
+      m_inEdges[slot] = edge;
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::UpdateMetrics()
+{
+  bool linkStateChanged = false;
+  for (size_t edge = 0; edge < m_faces.size(); edge++) {
+    uint16_t metric = m_faces[edge] == nullptr ? 0
+                                               : static_cast<uint16_t>(m_faces[edge]->getMetric());
+    linkStateChanged = linkStateChanged || IsDown(metric) != IsDown(m_metrics[edge]);
+    m_metrics[edge] = metric;
+  }
+
+  if (linkStateChanged)
+    m_linkStateVersion++;
+}
+
+void
+GlobalRoutingGraph::ShortestPathsFrom(uint32_t source, GlobalRouter::DistanceList& distances,
+                                      std::vector<uint32_t>* predecessors) const
+{
+  Run(source, false, distances, predecessors);
+}
+
+void
+GlobalRoutingGraph::ShortestPathsTo(uint32_t target, GlobalRouter::DistanceList& distances,
+                                    std::vector<uint32_t>* successors) const
+{
+  Run(target, true, distances, successors);
+}
+
+void
+GlobalRoutingGraph::HopCounts(uint32_t start, bool reverse, std::vector<uint16_t>& hops) const
+{
+  uint32_t size = m_routers.size();
+  hops.assign(size, std::numeric_limits<uint16_t>::max());
+  if (start >= size || m_routers[start] == 0)
+    return;
+
+  const std::vector<uint32_t>& offsets = reverse ? m_inOffsets : m_outOffsets;
+  const std::vector<uint32_t>& neighbors = reverse ? m_inSources : m_outTargets;
+
+  // 0-1 breadth-first search, edges from channels to nodes are free
+  std::deque<uint32_t> queue;
+  hops[start] = 0;
+  queue.push_back(start);
+
+  while (!queue.empty()) {
+    uint32_t vertex = queue.front();
+    queue.pop_front();
+
+    for (uint32_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+      uint32_t edge = reverse ? m_inEdges[i] : i;
+      uint32_t neighbor = neighbors[i];
+      if (IsDown(m_metrics[edge]))
+        continue;
+
+      uint16_t weight = m_faces[edge] != nullptr ? 1 : 0;
+      if (hops[vertex] + weight >= hops[neighbor])
+        continue;
+
+      hops[neighbor] = hops[vertex] + weight;
+      if (weight == 0)
+        queue.push_front(neighbor);
+      else
+        queue.push_back(neighbor);
+    }
+  }
+}
+
+void
+GlobalRoutingGraph::Run(uint32_t start, bool reverse, GlobalRouter::DistanceList& distances,
+                        std::vector<uint32_t>* parents) const
+{
+  uint32_t size = m_routers.size();
+
+  distances.assign(size, GlobalRouter::Distance(nullptr, INFINITE_COST, 0.0));
+  if (parents != nullptr)
+    parents->assign(size, NO_VERTEX);
+
+  if (start >= size || m_routers[start] == 0)
+    return;
+
+  const std::vector<uint32_t>& offsets = reverse ? m_inOffsets : m_outOffsets;
+  const std::vector<uint32_t>& neighbors = reverse ? m_inSources : m_outTargets;
+
+  VertexHeap heap(size);
+  distances[start] = GlobalRouter::Distance(nullptr, 0, 0.0);
+  heap.Update(start, 0);
+
+  while (!heap.IsEmpty()) {
+    uint32_t vertex = heap.Pop();
+    uint32_t cost = std::get<1>(distances[vertex]);
+    double delay = std::get<2>(distances[vertex]);
+
+    for (uint32_t i = offsets[vertex]; i < offsets[vertex + 1]; i++) {
+      uint32_t edge = reverse ? m_inEdges[i] : i;
+      uint32_t neighbor = neighbors[i];
+      uint32_t newCost = cost + m_metrics[edge];
+      if (newCost >= std::get<1>(distances[neighbor]))
+        continue;
+
+      // first hop face of the path, channels have no faces of their own
+      const shared_ptr<Face>& face = m_faces[edge];
+      const shared_ptr<Face>& hop = std::get<0>(distances[vertex]);
+      double newDelay = delay + m_delays[edge];
+      if (reverse)
+        distances[neighbor] = GlobalRouter::Distance(face != nullptr ? face : hop, newCost,
+                                                     newDelay);
+      else
+        distances[neighbor] = GlobalRouter::Distance(hop != nullptr ? hop : face, newCost,
+                                                     newDelay);
+
+      if (parents != nullptr)
+        (*parents)[neighbor] = vertex;
+      heap.Update(neighbor, newCost);
+    }
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
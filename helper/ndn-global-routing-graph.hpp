@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_GLOBAL_ROUTING_GRAPH_H
+#define NDN_GLOBAL_ROUTING_GRAPH_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
+
+#include "ns3/ptr.h"
+
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Cached compressed sparse row (CSR) view of the GlobalRouter graph
+ *
+ * Vertices are indexed by GlobalRouter::GetId (ids of routers that are not installed on a node
+ * or a channel are left empty).  Outgoing and incoming edges of every vertex are stored in flat
+ * arrays together with the face and the metric of the edge, so shortest path computations
+ * neither walk NodeList/ChannelList nor allocate per vertex.
+ *
+ * The structure is rebuilt only when the set of routers or incidencies changes (see
+ * GlobalRouter::GetTopologyVersion).  Link metrics are re-read from the faces on every
+ * GlobalRoutingGraph::Get, which is a single pass over the edge array.
+ *
+ * Once obtained, the graph is read-only: the const shortest path methods may run concurrently
+ * from several threads (they neither touch faces nor reference counts of routers).
+ */
+class GlobalRoutingGraph {
+public:
+  static const uint32_t INFINITE_COST = std::numeric_limits<uint16_t>::max();
+  static const uint32_t NO_VERTEX = std::numeric_limits<uint32_t>::max();
+
+  /**
+   * @brief Neighbor router reachable over one face of a vertex
+   */
+  struct Adjacency {
+    shared_ptr<Face> face;
+    uint32_t neighbor;
+    uint32_t cost; ///< @brief metric of the link
+  };
+
+  /**
+   * @brief Get the graph of the current topology, with up-to-date link metrics
+   *
+   * The cached graph is released on Simulator::Destroy.
+   */
+  static GlobalRoutingGraph&
+  Get();
+
+  /**
+   * @brief Get a number that changes whenever the graph is rebuilt or a link goes down or up
+   *
+   * Unlike GlobalRouter::GetTopologyVersion, it also follows link failures (metric changes to or
+   * from INFINITE_COST - 1 or more), so results of HopCounts can be cached against it.
+   */
+  uint32_t
+  GetLinkStateVersion() const;
+
+  /**
+   * @brief Get the number of vertex slots, i.e., the largest router id plus one
+   */
+  uint32_t
+  GetSize() const;
+
+  /**
+   * @brief Get the router with the given id, or 0 if the id is not part of the graph
+   */
+  Ptr<GlobalRouter>
+  GetRouter(uint32_t id) const;
+
+  /**
+   * @brief Get all routers, indexed by id (with empty slots)
+   */
+  const std::vector<Ptr<GlobalRouter>>&
+  GetRouters() const;
+
+  /**
+   * @brief Get the neighbor routers of @p vertex, in the order of its outgoing edges
+   *
+   * Channel vertices of multi-access links are looked through, i.e., a face connected to such
+   * a link yields one Adjacency for every other router on it.
+   */
+  void
+  GetAdjacencies(uint32_t vertex, std::vector<Adjacency>& adjacencies) const;
+
+  /**
+   * @brief Compute shortest paths from @p source to every vertex
+   *
+   * Every resulting Distance holds the first hop face of the path from @p source (nullptr if
+   * unreachable) and the path cost, as dijkstra_shortest_paths over NdnGlobalRouterGraph
+   * reports them.  Paths with cost INFINITE_COST or more are unreachable.
+   *
+   * The delay element is the sum of the "Delay" attributes of the channels along the path, in
+   * seconds (channels without the attribute add 0), read when the graph is built.  The Boost
+   * edge weights always report a zero delay.
+   *
+   * @param predecessors if not null, filled with the previous vertex on every path
+   */
+  void
+  ShortestPathsFrom(uint32_t source, GlobalRouter::DistanceList& distances,
+                    std::vector<uint32_t>* predecessors = nullptr) const;
+
+  /**
+   * @brief Compute shortest paths from every vertex to @p target
+   *
+   * Dijkstra over the reversed edges.  Every resulting Distance holds the face of the first hop
+   * from that vertex towards @p target, the path cost, and the path delay.
+   *
+   * @param successors if not null, filled with the next vertex on every path
+   */
+  void
+  ShortestPathsTo(uint32_t target, GlobalRouter::DistanceList& distances,
+                  std::vector<uint32_t>* successors = nullptr) const;
+
+  /**
+   * @brief Compute the number of hops between @p start and every vertex, ignoring metrics
+   *
+   * Only edges leaving a face count as a hop, so a multi-access channel is one hop as a
+   * point-to-point link is.  Links that are down (metric INFINITE_COST - 1 or more, see
+   * LinkControlHelper::FailLink) are not followed.  Unreachable vertices get
+   * std::numeric_limits<uint16_t>::max().
+   *
+   * @param reverse if true, hops from every vertex to @p start are computed instead
+   */
+  void
+  HopCounts(uint32_t start, bool reverse, std::vector<uint16_t>& hops) const;
+
+private:
+  GlobalRoutingGraph();
+
+  void
+  Build();
+
+  void
+  Run(uint32_t start, bool reverse, GlobalRouter::DistanceList& distances,
+      std::vector<uint32_t>* parents) const;
+
+  void
+  UpdateMetrics();
+
+  static GlobalRoutingGraph&
+  Instance();
+
+  static void
+  Reset();
+
+private:
+  uint32_t m_topologyVersion;
+  bool m_built;
+  uint32_t m_linkStateVersion;
+
+  std::vector<Ptr<GlobalRouter>> m_routers;
+
+  // edges are numbered in outgoing order: outgoing edges of vertex v are
+  // [m_outOffsets[v], m_outOffsets[v + 1])
+  std::vector<uint32_t> m_outOffsets;
+  std::vector<uint32_t> m_outTargets;
+
+  // incoming edges of vertex v are m_inEdges[m_inOffsets[v] .. m_inOffsets[v + 1])
+  std::vector<uint32_t> m_inOffsets;
+  std::vector<uint32_t> m_inSources;
+  std::vector<uint32_t> m_inEdges;
+
+  std::vector<shared_ptr<Face>> m_faces; ///< @brief face of the tail vertex, nullptr for channels
+  std::vector<uint16_t> m_metrics;
+  std::vector<double> m_delays; ///< @brief channel delay of every edge, in seconds
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_GLOBAL_ROUTING_GRAPH_H
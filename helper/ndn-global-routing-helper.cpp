@@ -29,6 +29,7 @@
 #include "helper/ndn-fib-helper.hpp"
 #include "model/ndn-net-device-face.hpp"
 #include "model/ndn-global-router.hpp"
+#include "ndn-global-routing-graph.hpp"
 
 #include "daemon/table/fib.hpp"
 #include "daemon/fw/forwarder.hpp"
@@ -46,15 +47,16 @@
 #include "ns3/node-list.h"
 #include "ns3/channel-list.h"
 #include "ns3/object-factory.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
 
 #include <boost/lexical_cast.hpp>
 #include <boost/foreach.hpp>
-#include <boost/concept/assert.hpp>
-#include <boost/graph/dijkstra_shortest_paths.hpp>
 
+#include <set>
 #include <unordered_map>
-
-#include "boost-graph-ndn-global-routing-helper.hpp"
+#include <atomic>
+#include <thread>
 
 #include <math.h>
 
@@ -65,6 +67,54 @@ using namespace nfd::fw;
 namespace ns3 {
 namespace ndn {
 
+/* PDRM Change */
+static GlobalValue g_globalRoutingThreads =
+  GlobalValue("GlobalRoutingThreads",
+              "Number of threads computing shortest path trees in GlobalRoutingHelper "
+              "(0 for one per hardware thread)",
+              UintegerValue(1), MakeUintegerChecker<uint32_t>());
+
+// Number of shortest path trees computed before they are applied to the FIBs, which bounds
+// the memory held by the compute phase
+static const size_t ROUTING_BATCH_SIZE = 256;
+
+/**
+ * @brief Run @p task for every index in [0, count) on GlobalRoutingThreads threads
+ *
+ * Tasks may only read the GlobalRoutingGraph and write to their own result slot, so results
+ * do not depend on the number of threads.  All ns-3 and NFD state is left to the caller.
+ */
+static void
+ComputeInParallel(size_t count, const std::function<void(size_t)>& task)
+{
+  UintegerValue threadsValue;
+  g_globalRoutingThreads.GetValue(threadsValue);
+  size_t threads = threadsValue.Get();
+  if (threads == 0)
+    threads = std::max(std::thread::hardware_concurrency(), 1u);
+  threads = std::min(threads, count);
+
+  if (threads <= 1) {
+    for (size_t i = 0; i < count; i++)
+      task(i);
+    return;
+  }
+
+  std::atomic<size_t> next(0);
+  auto worker = [&] {
+    for (size_t i = next++; i < count; i = next++)
+      task(i);
+  };
+
+  std::vector<std::thread> pool;
+  for (size_t i = 1; i < threads; i++)
+    pool.push_back(std::thread(worker));
+  worker();
+  for (auto& thread : pool)
+    thread.join();
+}
+/* PDRM Change */
+
 void
 GlobalRoutingHelper::Install(Ptr<Node> node)
 {
@@ -191,8 +241,12 @@ GlobalRoutingHelper::RemoveOrigin(const std::string& prefix, Ptr<Node> node)
   auto name = make_shared<Name>(prefix);
   gr->RemoveLocalPrefix(name);
 
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    FibHelper::RemoveRoutes(*node, prefix);
+  // only routers that hold next hops for the prefix, instead of every node
+  for (const auto& holder : GlobalRouter::GetRouteHolders(*name)) {
+    FibHelper::RemoveRoutes(holder->GetObject<Node>(), *name);
+
+    // routes are gone, CalculateRoutesIncremental must install them again if still announced
+    holder->GetInstalledRoutes().erase(*name);
   }
 }
 /* PDRM Change */
@@ -240,139 +294,226 @@ GlobalRoutingHelper::AddOriginsForAll()
 uint32_t
 GlobalRoutingHelper::CalculateRoutes()
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
   uint32_t changes = 0;
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
-
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  /* PDRM Change */
+  // Dijkstra for every node, on the cached CSR view of the router graph.  Trees are computed
+  // in parallel batches and applied to the FIBs serially, in NodeList order
+  GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+  const std::vector<Ptr<GlobalRouter>>& routers = graph.GetRouters();
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
+  std::vector<Ptr<GlobalRouter>> sources;
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
       NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
       continue;
     }
+    sources.push_back(source);
+  }
 
-    vector<Name> announcedPrefixes;
+  std::vector<GlobalRouter::DistanceList> trees;
+  for (size_t batch = 0; batch < sources.size(); batch += ROUTING_BATCH_SIZE) {
+    size_t batchSize = std::min(ROUTING_BATCH_SIZE, sources.size() - batch);
+    trees.resize(batchSize);
 
-    for (auto& pr : source->GetLocalPrefixes()) {
-      announcedPrefixes.push_back(*pr);
-      NS_LOG_DEBUG(*pr);
-    }
-    
+    std::vector<uint32_t> ids(batchSize);
+    for (size_t i = 0; i < batchSize; i++)
+      ids[i] = sources[batch + i]->GetId();
+
+    ComputeInParallel(batchSize, [&] (size_t i) { graph.ShortestPathsFrom(ids[i], trees[i]); });
+
+    for (size_t i = 0; i < batchSize; i++)
+      changes += ApplyRoutes(sources[batch + i], routers, trees[i]);
+  }
+
+  NS_LOG_DEBUG("Total changes: " << changes);
+  return changes;
+  /* PDRM Change */
+}
+
+/* PDRM Change */
+uint32_t
+GlobalRoutingHelper::ApplyRoutes(Ptr<GlobalRouter> source,
+                                 const std::vector<Ptr<GlobalRouter>>& routers,
+                                 const GlobalRouter::DistanceList& distances)
+{
+  uint32_t changes = 0;
+  Ptr<Node> node = source->GetObject<Node>();
 
-    boost::DistancesMap distances;
+  source->GetInstalledRoutes().clear();
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+  vector<Name> announcedPrefixes;
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+  for (auto& pr : source->GetLocalPrefixes()) {
+    announcedPrefixes.push_back(*pr);
+    NS_LOG_DEBUG(*pr);
+  }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+  Ptr<L3Protocol> L3protocol = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
 
-    for (auto& i : L3protocol->getForwarder()->getFaceTable()) {
-      shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
-      NS_LOG_DEBUG("FACE METRIC: " << nfdFace->getId() << "(" << nfdFace->getMetric() << ")");
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
-    }
+  for (auto& i : L3protocol->getForwarder()->getFaceTable()) {
+    shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
+    NS_LOG_DEBUG("FACE METRIC: " << nfdFace->getId() << "(" << nfdFace->getMetric() << ")");
+    // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+  }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
+  NS_LOG_DEBUG("Reachability from Node: " << node->GetId());
+  for (uint32_t id = 0; id < distances.size(); id++) {
+    const Ptr<GlobalRouter>& router = routers[id];
+    const GlobalRouter::Distance& distance = distances[id];
+    if (router == 0 || router == source)
+      continue;
+    else {
+      // cout << "  Node " << router->GetObject<Node> ()->GetId ();
+      if (std::get<0>(distance) == 0) {
+        // cout << " is unreachable" << endl;
+      }
       else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
-        }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            //NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-            //             << " with distance " << std::get<1>(dist.second) << " with delay "
-            //             << std::get<2>(dist.second));
-
-            //shared_ptr<fib::Entry> fibEntry = forwarder->getFib().findLongestPrefixMatch(*prefix);
-            /* PDRM Change */
-            if (prefix->toUri() == "/prod")
-            {
-            for (const auto& nexthops : forwarder->getFib().findLongestPrefixMatch(*prefix)->getNextHops()) {
-              shared_ptr<Face> face = std::get<0>(dist.second);
-              if (nexthops.getFace()->getId() != face->getId()) {
-                NS_LOG_DEBUG("Change for " << *prefix << ": " << nexthops.getFace()->getId() << " == " << face->getId());
-                changes++;
-              }
-            }
+        for (const auto& prefix : router->GetLocalPrefixes()) {
+          //NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(distance)
+          //             << " with distance " << std::get<1>(distance) << " with delay "
+          //             << std::get<2>(distance));
+
+          //shared_ptr<fib::Entry> fibEntry = forwarder->getFib().findLongestPrefixMatch(*prefix);
+          /* PDRM Change */
+          if (prefix->toUri() == "/prod")
+          {
+          for (const auto& nexthops : forwarder->getFib().findLongestPrefixMatch(*prefix)->getNextHops()) {
+            shared_ptr<Face> face = std::get<0>(distance);
+            if (nexthops.getFace()->getId() != face->getId()) {
+              NS_LOG_DEBUG("Change for " << *prefix << ": " << nexthops.getFace()->getId() << " == " << face->getId());
+              changes++;
             }
-            /* PDRM Change */
-
-//	    FibHelper::RemoveRoutes(*node, *prefix);
           }
+          }
+          /* PDRM Change */
 
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            bool update = true;
+//	    FibHelper::RemoveRoutes(node, *prefix);
+        }
 
-            for (int i = 0; i < announcedPrefixes.size(); i++) {
-              if (announcedPrefixes[i].isPrefixOf(*prefix)) {
-                update = false;
-                break;
-              }
-            }
+        for (const auto& prefix : router->GetLocalPrefixes()) {
+          bool update = true;
 
-  	    if (std::get<1>(dist.second) == 65534 || !update) {
-              FibHelper::RemoveRoutes(*node, *prefix);
-            } else {
-              NS_LOG_DEBUG(*node << " " << *prefix << " " << std::get<0>(dist.second) << " " << std::get<1>(dist.second));
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
+          for (int i = 0; i < announcedPrefixes.size(); i++) {
+            if (announcedPrefixes[i].isPrefixOf(*prefix)) {
+              update = false;
+              break;
             }
           }
+
+          if (std::get<1>(distance) == 65534 || !update) {
+            FibHelper::RemoveRoutes(node, *prefix);
+          } else {
+            NS_LOG_DEBUG(node << " " << *prefix << " " << std::get<0>(distance) << " " << std::get<1>(distance));
+            source->AddRoute(*prefix, std::get<0>(distance), std::get<1>(distance));
+          }
         }
       }
     }
   }
-  /* PDRM Change */
-  NS_LOG_DEBUG("Total changes: " << changes);
+
   return changes;
-  /* PDRM Change */
 }
+/* PDRM Change */
 
 /* PDRM Change */
 uint32_t
 GlobalRoutingHelper::CalculateRoutes(const std::string& prefix)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
   uint32_t changes = 0;
+  Name name(prefix);
+
+  GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+
+  // A node does not route towards prefixes under the ones it originates, so a change of the
+  // origins of the prefix may also add or remove routes to every more specific routed prefix
+  std::set<Name> prefixes;
+  prefixes.insert(name);
+  for (const auto& router : graph.GetRouters()) {
+    if (router == 0)
+      continue;
+
+    for (const auto& local : router->GetLocalPrefixes()) {
+      if (name.isPrefixOf(*local))
+        prefixes.insert(*local);
+    }
+  }
+
+  for (const Name& routed : prefixes) {
+    // One reverse shortest path tree per origin of the prefix, instead of one tree per node
+    OriginDistanceList origins;
+    for (const auto& router : graph.GetRouters()) {
+      if (router == 0)
+        continue;
+
+      for (const auto& local : router->GetLocalPrefixes()) {
+        if (*local == routed) {
+          origins.push_back(std::make_pair(router, GlobalRouter::DistanceList()));
+          graph.ShortestPathsTo(router->GetId(), origins.back().second);
+          break;
+        }
+      }
+    }
+
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+      if (source == 0) {
+        NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+        continue;
+      }
+
+      changes += UpdateRoutes(*node, source, routed, origins);
+    }
+  }
+
+  NS_LOG_DEBUG("Total changes for " << name << ": " << changes);
+  return changes;
+}
+/* PDRM Change */
+
+uint32_t
+GlobalRoutingHelper::CalculateRoutesIncremental()
+{
+  uint32_t changes = 0;
+
+  GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+  const std::vector<Ptr<GlobalRouter>>& routers = graph.GetRouters();
+
+  // Find links whose metric changed since the previous computation
+  typedef std::tuple<Ptr<GlobalRouter>, Ptr<GlobalRouter>, uint16_t, uint16_t> MetricChange;
+  std::list<MetricChange> metricChanges;
+  bool topologyChanged = false;
+
+  for (const auto& vertex : routers) {
+    if (vertex == 0)
+      continue;
+
+    std::vector<uint16_t>& metrics = vertex->GetIncidencyMetrics();
+    if (metrics.size() != vertex->GetIncidencies().size()) {
+      topologyChanged = true;
+      metrics.resize(vertex->GetIncidencies().size(), 0);
+    }
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+    size_t i = 0;
+    for (const auto& edge : vertex->GetIncidencies()) {
+      uint16_t metric = 0;
+      if (std::get<1>(edge) != nullptr)
+        metric = static_cast<uint16_t>(std::get<1>(edge)->getMetric());
+      if (metrics[i] != metric) {
+        metricChanges.push_back(std::make_tuple(std::get<0>(edge), std::get<2>(edge), metrics[i],
+                                                metric));
+        metrics[i] = metric;
+      }
+      i++;
+    }
+  }
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  // Affected trees are recomputed in parallel, FIBs are updated serially in NodeList order
+  std::vector<Ptr<GlobalRouter>> sources;
+  std::vector<std::pair<uint32_t, GlobalRouter::DistanceList*>> recompute;
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
     Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
     if (source == 0) {
@@ -380,184 +521,360 @@ GlobalRoutingHelper::CalculateRoutes(const std::string& prefix)
       continue;
     }
 
-    boost::DistancesMap distances;
+    GlobalRouter::DistanceList& distances = source->GetDistances();
 
-    dijkstra_shortest_paths(graph, source,
-                            // predecessor_map (boost::ref(predecessors))
-                            // .
-                            distance_map(boost::ref(distances))
-                              .distance_inf(boost::WeightInf)
-                              .distance_zero(boost::WeightZero)
-                              .distance_compare(boost::WeightCompare())
-                              .distance_combine(boost::WeightCombine()));
+    bool affected = topologyChanged || distances.size() != routers.size();
+    for (const auto& change : metricChanges) {
+      if (affected)
+        break;
 
-    // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+      uint32_t from = std::get<1>(distances[std::get<0>(change)->GetId()]);
+      uint32_t to = std::get<1>(distances[std::get<1>(change)->GetId()]);
+      uint32_t oldMetric = std::get<2>(change);
+      uint32_t newMetric = std::get<3>(change);
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+      if (from >= GlobalRoutingGraph::INFINITE_COST)
+        continue;
+
+      if (newMetric > oldMetric) {
+        // link may be part of the shortest path tree
+        affected = to < GlobalRoutingGraph::INFINITE_COST && from + oldMetric == to;
+      }
+      else {
+        // link may provide a shorter (or equal cost) path
+        affected = from + newMetric < GlobalRoutingGraph::INFINITE_COST && from + newMetric <= to;
+      }
+    }
 
-/*
-    for (auto& i : L3protocol->getForwarder()->getFaceTable()) {
-      shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
-      NS_LOG_DEBUG("FACE METRIC: " << nfdFace->getId() << "(" << nfdFace->getMetric() << ")");
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+    if (affected) {
+      NS_LOG_DEBUG("Recomputing shortest path tree of Node " << (*node)->GetId());
+      recompute.push_back(std::make_pair(source->GetId(), &distances));
     }
-*/
+    sources.push_back(source);
+  }
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId());
-    for (const auto& dist : distances) {
-      if (dist.first == source)
-        continue;
-      else {
-        // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-        if (std::get<0>(dist.second) == 0) {
-          // cout << " is unreachable" << endl;
+  ComputeInParallel(recompute.size(), [&] (size_t i) {
+    graph.ShortestPathsFrom(recompute[i].first, *recompute[i].second);
+  });
+
+  for (const auto& source : sources) {
+    changes += UpdateRoutes(source->GetObject<Node>(), source, routers);
+  }
+
+  NS_LOG_DEBUG("Total changes: " << changes);
+  return changes;
+}
+
+uint32_t
+GlobalRoutingHelper::UpdateRoutes(Ptr<Node> node, Ptr<GlobalRouter> source,
+                                  const std::vector<Ptr<GlobalRouter>>& routers)
+{
+  uint32_t changes = 0;
+
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::Forwarder> forwarder = l3->getForwarder();
+  const GlobalRouter::DistanceList& distances = source->GetDistances();
+
+  // FIB updates in the same order CalculateRoutes would apply them
+  std::vector<std::tuple<shared_ptr<Name>, shared_ptr<Face>, uint32_t, bool>> updates;
+  GlobalRouter::InstalledRouteMap routes;
+
+  for (size_t id = 0; id < distances.size(); id++) {
+    if (routers[id] == 0 || routers[id] == source)
+      continue;
+
+    shared_ptr<Face> face = std::get<0>(distances[id]);
+    uint32_t cost = std::get<1>(distances[id]);
+    if (face == 0)
+      continue;
+
+    for (const auto& prefix : routers[id]->GetLocalPrefixes()) {
+      bool update = true;
+      for (const auto& announced : source->GetLocalPrefixes()) {
+        if (announced->isPrefixOf(*prefix)) {
+          update = false;
+          break;
         }
-        else {
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            //NS_LOG_DEBUG(" prefix " << prefix << " reachable via face " << *std::get<0>(dist.second)
-            //             << " with distance " << std::get<1>(dist.second) << " with delay "
-            //             << std::get<2>(dist.second));
-
-            //shared_ptr<fib::Entry> fibEntry = forwarder->getFib().findLongestPrefixMatch(*prefix);
-            if (prefix->toUri() == "/prod")
-            {
-            for (const auto& nexthops : forwarder->getFib().findLongestPrefixMatch(*prefix)->getNextHops()) {
-              shared_ptr<Face> face = std::get<0>(dist.second);
-              if (nexthops.getFace()->getId() != face->getId()) {
-                NS_LOG_DEBUG("Change for " << *prefix << ": " << nexthops.getFace()->getId() << " == " << face->getId());
-                changes++;
-              }
-            }
-            }
+      }
 
-	    FibHelper::RemoveRoutes(*node, *prefix);
-          }
+      update = update && cost != 65534;
+      updates.push_back(std::make_tuple(prefix, face, cost, update));
+      routes[*prefix].push_back(std::make_pair(update ? face : nullptr, update ? cost : 0));
+    }
+  }
 
-          for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-            FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                std::get<1>(dist.second));
-          }
+  GlobalRouter::InstalledRouteMap& installed = source->GetInstalledRoutes();
+
+  for (const auto& update : updates) {
+    const shared_ptr<Name>& prefix = std::get<0>(update);
+    const shared_ptr<Face>& face = std::get<1>(update);
+
+    if (prefix->toUri() == "/prod") {
+      for (const auto& nexthops : forwarder->getFib().findLongestPrefixMatch(*prefix)->getNextHops()) {
+        if (nexthops.getFace()->getId() != face->getId()) {
+          NS_LOG_DEBUG("Change for " << *prefix << ": " << nexthops.getFace()->getId() << " == " << face->getId());
+          changes++;
         }
       }
     }
+
+    // replay all updates of a prefix if any of them differs from the previous computation
+    auto previous = installed.find(*prefix);
+    if (previous != installed.end() && previous->second == routes[*prefix])
+      continue;
+
+    if (std::get<3>(update)) {
+      source->AddRoute(*prefix, face, std::get<2>(update));
+    }
+    else {
+      FibHelper::RemoveRoutes(node, *prefix);
+    }
   }
-  NS_LOG_DEBUG("Total changes: " << changes);
+
+  installed.swap(routes);
   return changes;
 }
-/* PDRM Change */
 
-void
-GlobalRoutingHelper::CalculateAllPossibleRoutes()
+uint32_t
+GlobalRoutingHelper::UpdateRoutes(Ptr<Node> node, Ptr<GlobalRouter> source, const Name& prefix,
+                                  const OriginDistanceList& origins)
 {
-  /**
-   * Implementation of route calculation is heavily based on Boost Graph Library
-   * See http://www.boost.org/doc/libs/1_49_0/libs/graph/doc/table_of_contents.html for more details
-   */
+  uint32_t changes = 0;
 
-  BOOST_CONCEPT_ASSERT((boost::VertexListGraphConcept<boost::NdnGlobalRouterGraph>));
-  BOOST_CONCEPT_ASSERT((boost::IncidenceGraphConcept<boost::NdnGlobalRouterGraph>));
+  Ptr<L3Protocol> l3 = node->GetObject<L3Protocol>();
+  shared_ptr<nfd::Forwarder> forwarder = l3->getForwarder();
 
-  boost::NdnGlobalRouterGraph graph;
-  // typedef graph_traits < NdnGlobalRouterGraph >::vertex_descriptor vertex_descriptor;
+  bool announced = false;
+  for (const auto& local : source->GetLocalPrefixes()) {
+    if (local->isPrefixOf(prefix)) {
+      announced = true;
+      break;
+    }
+  }
 
-  // For now we doing Dijkstra for every node.  Can be replaced with Bellman-Ford or Floyd-Warshall.
-  // Other algorithms should be faster, but they need additional EdgeListGraph concept provided by
-  // the graph, which
-  // is not obviously how implement in an efficient manner
-  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
-    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
-    if (source == 0) {
-      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+  // same actions, in the same order, as UpdateRoutes would apply for this prefix
+  GlobalRouter::RouteActionList routes;
+  for (const auto& origin : origins) {
+    if (origin.first == source)
       continue;
-    }
 
-    Ptr<L3Protocol> L3protocol = (*node)->GetObject<L3Protocol>();
-    shared_ptr<nfd::Forwarder> forwarder = L3protocol->getForwarder();
+    const GlobalRouter::Distance& distance = origin.second[source->GetId()];
+    shared_ptr<Face> face = std::get<0>(distance);
+    uint32_t cost = std::get<1>(distance);
+    if (face == 0)
+      continue;
 
-    NS_LOG_DEBUG("Reachability from Node: " << source->GetObject<Node>()->GetId() << " ("
-                                            << Names::FindName(source->GetObject<Node>()) << ")");
+    bool update = !announced && cost != 65534;
+    routes.push_back(std::make_pair(update ? face : nullptr, update ? cost : 0));
 
-    Ptr<L3Protocol> l3 = source->GetObject<L3Protocol>();
-    NS_ASSERT(l3 != 0);
+    if (prefix.toUri() == "/prod") {
+      for (const auto& nexthops : forwarder->getFib().findLongestPrefixMatch(prefix)->getNextHops()) {
+        if (nexthops.getFace()->getId() != face->getId()) {
+          NS_LOG_DEBUG("Change for " << prefix << ": " << nexthops.getFace()->getId() << " == " << face->getId());
+          changes++;
+        }
+      }
+    }
+  }
+
+  GlobalRouter::InstalledRouteMap& installed = source->GetInstalledRoutes();
+  auto previous = installed.find(prefix);
+  if (previous != installed.end() && previous->second == routes)
+    return changes;
 
-    // remember interface statuses
-    std::list<nfd::FaceId> faceIds;
-    std::unordered_map<nfd::FaceId, uint16_t> originalMetrics;
-    for (auto& i : l3->getForwarder()->getFaceTable()) {
-      shared_ptr<Face> nfdFace = std::dynamic_pointer_cast<Face>(i);
-      faceIds.push_back(nfdFace->getId());
-      originalMetrics[nfdFace->getId()] = nfdFace->getMetric();
-      nfdFace->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-      // value std::numeric_limits<uint16_t>::max () MUST NOT be used (reserved)
+  for (const auto& route : routes) {
+    if (route.first != nullptr) {
+      source->AddRoute(prefix, route.first, route.second);
     }
+    else {
+      FibHelper::RemoveRoutes(node, prefix);
+    }
+  }
 
-    for (auto& faceId : faceIds) {
-      shared_ptr<Face> k = l3->getForwarder()->getFaceTable().get(faceId);
-      shared_ptr<NetDeviceFace> face = std::dynamic_pointer_cast<NetDeviceFace>(k);
-      if (face == 0) {
-        NS_LOG_DEBUG("Skipping non-netdevice face");
-        continue;
-      }
+  if (routes.empty())
+    installed.erase(prefix);
+  else
+    installed[prefix].swap(routes);
 
-      // enabling only faceId
-      face->setMetric(originalMetrics[faceId]);
+  return changes;
+}
 
-      boost::DistancesMap distances;
+/* PDRM Change */
+/**
+ * @brief Number the vertices of a shortest path tree in depth-first order
+ *
+ * After the call, @p u lies on the tree path from @p v to the root iff
+ * enter[u] <= enter[v] && leave[v] <= leave[u].  Vertices outside of the tree get NO_VERTEX.
+ */
+static void
+NumberTree(uint32_t root, const std::vector<uint32_t>& parents, std::vector<uint32_t>& enter,
+           std::vector<uint32_t>& leave)
+{
+  uint32_t size = parents.size();
 
-      NS_LOG_DEBUG("-----------");
+  // children of every vertex, in CSR layout
+  std::vector<uint32_t> offsets(size + 1, 0);
+  for (uint32_t v = 0; v < size; v++) {
+    if (parents[v] != GlobalRoutingGraph::NO_VERTEX)
+      offsets[parents[v] + 1]++;
+  }
+  for (uint32_t v = 0; v < size; v++) {
+    offsets[v + 1] += offsets[v];
+  }
+  std::vector<uint32_t> children(offsets[size]);
+  std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+  for (uint32_t v = 0; v < size; v++) {
+    if (parents[v] != GlobalRoutingGraph::NO_VERTEX)
+      children[fill[parents[v]]++] = v;
+  }
 
-      dijkstra_shortest_paths(graph, source,
-                              // predecessor_map (boost::ref(predecessors))
-                              // .
-                              distance_map(boost::ref(distances))
-                                .distance_inf(boost::WeightInf)
-                                .distance_zero(boost::WeightZero)
-                                .distance_compare(boost::WeightCompare())
-                                .distance_combine(boost::WeightCombine()));
+  enter.assign(size, GlobalRoutingGraph::NO_VERTEX);
+  leave.assign(size, GlobalRoutingGraph::NO_VERTEX);
+
+  uint32_t counter = 0;
+  std::vector<std::pair<uint32_t, uint32_t>> stack; // vertex, next child
+  enter[root] = counter++;
+  stack.push_back(std::make_pair(root, offsets[root]));
+  while (!stack.empty()) {
+    std::pair<uint32_t, uint32_t>& top = stack.back();
+    if (top.second == offsets[top.first + 1]) {
+      leave[top.first] = counter++;
+      stack.pop_back();
+      continue;
+    }
 
-      // NS_LOG_DEBUG (predecessors.size () << ", " << distances.size ());
+    uint32_t child = children[top.second++];
+    enter[child] = counter++;
+    stack.push_back(std::make_pair(child, offsets[child]));
+  }
+}
 
-      for (const auto& dist : distances) {
-        if (dist.first == source)
+void
+GlobalRoutingHelper::CalculateAllPossibleRoutes(uint32_t maxNextHops, bool loopFreeOnly)
+{
+  // Instead of one Dijkstra per (node, face), one reverse shortest path tree per origin gives
+  // the distance of every neighbor to it, and the cost of every face of a node is the link
+  // metric plus the distance of the neighbor behind it.  Trees are computed in parallel
+  // batches, routes are installed serially, in origin order
+  GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+  const std::vector<Ptr<GlobalRouter>>& routers = graph.GetRouters();
+
+  std::vector<uint32_t> sources;
+  std::vector<Ptr<GlobalRouter>> holders;
+  std::vector<std::vector<GlobalRoutingGraph::Adjacency>> adjacencies;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    Ptr<GlobalRouter> source = (*node)->GetObject<GlobalRouter>();
+    if (source == 0) {
+      NS_LOG_DEBUG("Node " << (*node)->GetId() << " does not export GlobalRouter interface");
+      continue;
+    }
+
+    source->GetInstalledRoutes().clear();
+
+    sources.push_back(source->GetId());
+    holders.push_back(source);
+    adjacencies.push_back(std::vector<GlobalRoutingGraph::Adjacency>());
+    graph.GetAdjacencies(source->GetId(), adjacencies.back());
+  }
+
+  std::vector<uint32_t> origins;
+  for (uint32_t id = 0; id < routers.size(); id++) {
+    if (routers[id] != 0 && !routers[id]->GetLocalPrefixes().empty())
+      origins.push_back(id);
+  }
+
+  // source index, adjacency index, path cost
+  typedef std::tuple<uint32_t, uint32_t, uint32_t> NextHop;
+  std::vector<std::vector<NextHop>> results;
+
+  for (size_t batch = 0; batch < origins.size(); batch += ROUTING_BATCH_SIZE) {
+    size_t batchSize = std::min(ROUTING_BATCH_SIZE, origins.size() - batch);
+    results.assign(batchSize, std::vector<NextHop>());
+
+    ComputeInParallel(batchSize, [&] (size_t i) {
+      uint32_t origin = origins[batch + i];
+      GlobalRouter::DistanceList distances;
+      std::vector<uint32_t> successors, enter, leave;
+      graph.ShortestPathsTo(origin, distances, &successors);
+      NumberTree(origin, successors, enter, leave);
+
+      std::vector<NextHop> nextHops;
+      for (uint32_t s = 0; s < sources.size(); s++) {
+        uint32_t source = sources[s];
+        if (source == origin || std::get<0>(distances[source]) == nullptr)
           continue;
-        else {
-          // cout << "  Node " << dist.first->GetObject<Node> ()->GetId ();
-          if (std::get<0>(dist.second) == 0) {
-            // cout << " is unreachable" << endl;
-          }
-          else {
-            for (const auto& prefix : dist.first->GetLocalPrefixes()) {
-              NS_LOG_DEBUG(" prefix " << *prefix << " reachable via face "
-                           << *std::get<0>(dist.second)
-                           << " with distance " << std::get<1>(dist.second)
-                           << " with delay " << std::get<2>(dist.second));
-
-              if (std::get<0>(dist.second)->getMetric() == std::numeric_limits<uint16_t>::max() - 1)
-                continue;
-
-              FibHelper::AddRoute(*node, *prefix, std::get<0>(dist.second),
-                                  std::get<1>(dist.second));
+
+        nextHops.clear();
+        for (uint32_t a = 0; a < adjacencies[s].size(); a++) {
+          const GlobalRoutingGraph::Adjacency& adjacency = adjacencies[s][a];
+          // failed links do not provide a route
+          if (adjacency.cost >= GlobalRoutingGraph::INFINITE_COST - 1)
+            continue;
+
+          uint32_t neighbor = adjacency.neighbor;
+          uint32_t cost = adjacency.cost + std::get<1>(distances[neighbor]);
+          if (cost >= GlobalRoutingGraph::INFINITE_COST)
+            continue;
+
+          // the shortest path of the neighbor must not return through the source, or Interests
+          // sent over the face come straight back
+          if (enter[source] <= enter[neighbor] && leave[neighbor] <= leave[source])
+            continue;
+
+          // downstream neighbors only: strictly closer to the origin than the source
+          if (loopFreeOnly && std::get<1>(distances[neighbor]) >= std::get<1>(distances[source]))
+            continue;
+
+          // several neighbors behind one face (multi-access link), the cheapest one counts
+          bool merged = false;
+          for (auto& nextHop : nextHops) {
+            if (adjacencies[s][std::get<1>(nextHop)].face == adjacency.face) {
+              std::get<2>(nextHop) = std::min(std::get<2>(nextHop), cost);
+              merged = true;
+              break;
             }
           }
+          if (!merged)
+            nextHops.push_back(std::make_tuple(s, a, cost));
         }
-      }
-
-      // disabling the face again
-      face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
-    }
 
-    // recover original interface statuses
-    for (auto& i : originalMetrics) {
-      l3->getForwarder()->getFaceTable().get(i.first)->setMetric(i.second);
+        if (maxNextHops > 0 && nextHops.size() > maxNextHops) {
+          std::stable_sort(nextHops.begin(), nextHops.end(),
+                           [] (const NextHop& a, const NextHop& b) {
+                             return std::get<2>(a) < std::get<2>(b);
+                           });
+          nextHops.resize(maxNextHops);
+        }
+        results[i].insert(results[i].end(), nextHops.begin(), nextHops.end());
+      }
+    });
+
+    for (size_t i = 0; i < batchSize; i++) {
+      Ptr<GlobalRouter> origin = routers[origins[batch + i]];
+      for (const auto& nextHop : results[i]) {
+        const GlobalRoutingGraph::Adjacency& adjacency =
+          adjacencies[std::get<0>(nextHop)][std::get<1>(nextHop)];
+
+        for (const auto& prefix : origin->GetLocalPrefixes()) {
+          NS_LOG_DEBUG("Node " << sources[std::get<0>(nextHop)] << ": prefix " << *prefix
+                       << " reachable via face " << *adjacency.face << " with distance "
+                       << std::get<2>(nextHop));
+          holders[std::get<0>(nextHop)]->AddRoute(*prefix, adjacency.face, std::get<2>(nextHop));
+        }
+      }
     }
   }
 }
+/* PDRM Change */
 
 /* PDRM Change */
 void
 GlobalRoutingHelper::PrintFIBs()
 {
+  // walking all FIBs is expensive, skip it unless the output is going somewhere
+  if (!g_log.IsEnabled(LOG_DEBUG))
+    return;
+
   for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
    NS_LOG_DEBUG("NODE " << (*node)->GetId());
    for (const auto& entry : (*node)->GetObject<L3Protocol>()->getForwarder()->getFib()) {
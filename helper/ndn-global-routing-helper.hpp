@@ -21,9 +21,12 @@
 #define NDN_GLOBAL_ROUTING_HELPER_H
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
+#include "ns3/ndnSIM/model/ndn-global-router.hpp"
 
 #include "ns3/ptr.h"
 
+#include <vector>
+
 namespace ns3 {
 
 class Node;
@@ -101,25 +104,65 @@ public:
 
   /**
    * @brief Calculate for every node shortest path trees and install routes to all prefix origins
+   *
+   * Shortest path trees are computed on the number of threads set by the "GlobalRoutingThreads"
+   * GlobalValue (1 by default, 0 for one per hardware thread) and applied to the FIBs on the
+   * simulator thread, so installed routes do not depend on the number of threads.
    */
   static uint32_t
   CalculateRoutes();
 
   /* PDRM Change */
+  /**
+   * @brief Recalculate routes to a single prefix, e.g., after its set of origins changed
+   *
+   * Instead of a shortest path tree from every node, one reverse shortest path tree is computed
+   * per origin of the prefix, which gives every node its next hop towards that origin.  Only FIB
+   * entries for the prefix and for the routed prefixes under it (whose routes depend on the
+   * prefixes each node originates) are touched, and only on nodes where they differ from the
+   * previously applied ones.
+   *
+   * Resulting FIB entries match CalculateRoutes (up to tie breaking between equal cost paths).
+   *
+   * @returns the number of next hop changes for the prefix, counted as CalculateRoutes does
+   */
   static uint32_t
   CalculateRoutes(const std::string& prefix);
+
+  /**
+   * @brief Incrementally update routes after link metric or origin changes
+   *
+   * Shortest path trees from the previous call are cached on every GlobalRouter.  Only the
+   * trees that may be affected by links whose metric changed since then (e.g., by
+   * LinkControlHelper::FailLink/UpLink) are recomputed, and only (node, prefix) FIB entries
+   * whose updates differ from the previously applied ones are touched.  The first call
+   * computes all trees.
+   *
+   * Resulting FIBs match CalculateRoutes (up to tie breaking between equal cost paths).
+   *
+   * @returns the same number of next hop changes as CalculateRoutes
+   */
+  static uint32_t
+  CalculateRoutesIncremental();
   /* PDRM Change */
 
   /**
    * @brief Calculate all possible next-hop independent alternative routes
    *
-   * Refer to the implementation for more details.
+   * For every node, every face over which a prefix origin is reachable is installed as a next
+   * hop, with the cost of the link plus the shortest path cost of the neighbor behind it.  Faces
+   * whose neighbor's shortest path towards the origin returns through the node itself are never
+   * installed.  One reverse shortest path tree is computed per origin (on
+   * "GlobalRoutingThreads" threads, see CalculateRoutes); face metrics are not modified.
    *
-   * Note that this method is highly experimental and should be used with caution (very time
-   *consuming).
+   * @param maxNextHops  if not 0, only the maxNextHops cheapest faces are installed per node
+   *                     and origin
+   * @param loopFreeOnly only install faces whose neighbor is strictly closer to the origin than
+   *                     the node (downstream neighbors), which keeps forwarding loop-free even
+   *                     when several alternates are in use at once
    */
   static void
-  CalculateAllPossibleRoutes();
+  CalculateAllPossibleRoutes(uint32_t maxNextHops = 0, bool loopFreeOnly = false);
 
   /* PDRM Change */
   static void
@@ -132,6 +175,23 @@ public:
 private:
   void
   Install(Ptr<Channel> channel);
+
+  /* PDRM Change */
+  typedef std::vector<std::pair<Ptr<GlobalRouter>, GlobalRouter::DistanceList>>
+    OriginDistanceList;
+
+  static uint32_t
+  ApplyRoutes(Ptr<GlobalRouter> source, const std::vector<Ptr<GlobalRouter>>& routers,
+              const GlobalRouter::DistanceList& distances);
+
+  static uint32_t
+  UpdateRoutes(Ptr<Node> node, Ptr<GlobalRouter> source,
+               const std::vector<Ptr<GlobalRouter>>& routers);
+
+  static uint32_t
+  UpdateRoutes(Ptr<Node> node, Ptr<GlobalRouter> source, const Name& prefix,
+               const OriginDistanceList& origins);
+  /* PDRM Change */
 };
 
 } // namespace ndn
@@ -0,0 +1,205 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-hop-distance-oracle.hpp"
+#include "ndn-global-routing-graph.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/node.h"
+#include "ns3/node-list.h"
+#include "ns3/simulator.h"
+#include "ns3/global-value.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.HopDistanceOracle");
+
+namespace ns3 {
+namespace ndn {
+
+const uint16_t HopDistanceOracle::UNREACHABLE;
+
+static GlobalValue g_hopDistanceLandmarks =
+  GlobalValue("HopDistanceLandmarks",
+              "Number of landmark nodes used to approximate hop distances between nodes "
+              "(0 to keep the exact distance matrix)",
+              UintegerValue(0), MakeUintegerChecker<uint32_t>());
+
+HopDistanceOracle&
+HopDistanceOracle::Get()
+{
+  HopDistanceOracle& oracle = Instance();
+
+  UintegerValue landmarks;
+  g_hopDistanceLandmarks.GetValue(landmarks);
+
+  // re-reads link metrics, so links failed or brought up since the last query are noticed
+  const GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+
+  if (!oracle.m_built || oracle.m_linkStateVersion != graph.GetLinkStateVersion()
+      || oracle.m_nodeCount != NodeList::GetNNodes()
+      || oracle.m_requestedLandmarks != landmarks.Get()) {
+    oracle.Build(landmarks.Get());
+  }
+
+  return oracle;
+}
+
+HopDistanceOracle&
+HopDistanceOracle::Instance()
+{
+  // never destroyed, Reset releases the tables on Simulator::Destroy
+  static HopDistanceOracle* oracle = new HopDistanceOracle();
+  return *oracle;
+}
+
+HopDistanceOracle::HopDistanceOracle()
+  : m_linkStateVersion(0)
+  , m_built(false)
+  , m_nodeCount(0)
+  , m_requestedLandmarks(0)
+  , m_landmarkCount(0)
+{
+}
+
+void
+HopDistanceOracle::Reset()
+{
+  Instance() = HopDistanceOracle();
+}
+
+bool
+HopDistanceOracle::IsExact() const
+{
+  return m_landmarkCount == 0;
+}
+
+uint16_t
+HopDistanceOracle::GetDistance(uint32_t from, uint32_t to) const
+{
+  if (from >= m_nodeCount || to >= m_nodeCount)
+    return UNREACHABLE;
+  if (from == to)
+    return 0;
+
+  if (m_landmarkCount == 0)
+    return m_distances[from * m_nodeCount + to];
+
+  uint32_t distance = UNREACHABLE;
+  for (uint32_t landmark = 0; landmark < m_landmarkCount; landmark++) {
+    uint32_t toLandmark = m_toLandmarks[landmark * m_nodeCount + from];
+    uint32_t fromLandmark = m_fromLandmarks[landmark * m_nodeCount + to];
+    if (toLandmark != UNREACHABLE && fromLandmark != UNREACHABLE)
+      distance = std::min(distance, toLandmark + fromLandmark);
+  }
+  return std::min<uint32_t>(distance, UNREACHABLE);
+}
+
+uint16_t
+HopDistanceOracle::GetDistance(Ptr<Node> from, Ptr<Node> to) const
+{
+  return GetDistance(from->GetId(), to->GetId());
+}
+
+void
+HopDistanceOracle::Build(uint32_t landmarks)
+{
+  if (!m_built)
+    Simulator::ScheduleDestroy(&HopDistanceOracle::Reset);
+
+  const GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+
+  m_linkStateVersion = graph.GetLinkStateVersion();
+  m_built = true;
+  m_nodeCount = NodeList::GetNNodes();
+  m_requestedLandmarks = landmarks;
+  m_landmarkCount = 0;
+  m_distances.clear();
+  m_fromLandmarks.clear();
+  m_toLandmarks.clear();
+
+  NS_LOG_DEBUG("Building hop distances of " << m_nodeCount << " nodes, " << landmarks
+                                            << " landmarks");
+
+  std::vector<uint32_t> routerIds(m_nodeCount, GlobalRoutingGraph::NO_VERTEX);
+  for (uint32_t node = 0; node < m_nodeCount; node++) {
+    Ptr<GlobalRouter> router = NodeList::GetNode(node)->GetObject<GlobalRouter>();
+    if (router != 0)
+      routerIds[node] = router->GetId();
+  }
+
+  // hops from (or to) a node, per node id
+  std::vector<uint16_t> hops;
+  auto fill = [&] (uint32_t node, bool reverse, uint16_t* row) {
+    graph.HopCounts(routerIds[node], reverse, hops);
+    for (uint32_t other = 0; other < m_nodeCount; other++) {
+      if (routerIds[other] != GlobalRoutingGraph::NO_VERTEX)
+        row[other] = hops[routerIds[other]];
+    }
+  };
+
+  if (landmarks == 0) {
+    m_distances.assign(m_nodeCount * m_nodeCount, UNREACHABLE);
+    for (uint32_t node = 0; node < m_nodeCount; node++) {
+      if (routerIds[node] != GlobalRoutingGraph::NO_VERTEX)
+        fill(node, false, &m_distances[node * m_nodeCount]);
+    }
+    return;
+  }
+
+  // Landmarks are picked farthest-first: each next landmark is the node with the most hops to
+  // the landmarks picked so far (nodes in other partitions first)
+  landmarks = std::min(landmarks, m_nodeCount);
+  m_fromLandmarks.assign(landmarks * m_nodeCount, UNREACHABLE);
+  m_toLandmarks.assign(landmarks * m_nodeCount, UNREACHABLE);
+
+  std::vector<uint32_t> closest(m_nodeCount, UNREACHABLE + 1);
+  for (uint32_t node = 0; node < m_nodeCount; node++) {
+    if (routerIds[node] == GlobalRoutingGraph::NO_VERTEX)
+      closest[node] = 0;
+  }
+
+  while (m_landmarkCount < landmarks) {
+    uint32_t landmark = std::max_element(closest.begin(), closest.end()) - closest.begin();
+    if (closest[landmark] == 0)
+      break; // every node with a GlobalRouter is a landmark
+
+    NS_LOG_DEBUG("Landmark " << m_landmarkCount << ": node " << landmark);
+
+    uint16_t* fromRow = &m_fromLandmarks[m_landmarkCount * m_nodeCount];
+    uint16_t* toRow = &m_toLandmarks[m_landmarkCount * m_nodeCount];
+    fill(landmark, false, fromRow);
+    fill(landmark, true, toRow);
+    m_landmarkCount++;
+
+    for (uint32_t node = 0; node < m_nodeCount; node++) {
+      closest[node] = std::min<uint32_t>(closest[node], fromRow[node]);
+    }
+    closest[landmark] = 0;
+  }
+
+  m_fromLandmarks.resize(m_landmarkCount * m_nodeCount);
+  m_toLandmarks.resize(m_landmarkCount * m_nodeCount);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_HOP_DISTANCE_ORACLE_H
+#define NDN_HOP_DISTANCE_ORACLE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/ptr.h"
+
+#include <limits>
+#include <vector>
+
+namespace ns3 {
+
+class Node;
+
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Hop distances between nodes of the GlobalRouter topology
+ *
+ * By default, the oracle keeps a node-by-node matrix of uint16 hop counts, filled by one
+ * breadth-first search per node over GlobalRoutingGraph, so a query is a single lookup.  For
+ * very large topologies, the "HopDistanceLandmarks" GlobalValue can be set to a number of
+ * landmark nodes: only hop counts from and to the landmarks are stored, and a distance is
+ * estimated as the shortest detour over a landmark (an upper bound, exact if a landmark lies
+ * on a shortest path).
+ *
+ * The oracle is rebuilt when the topology changes or a link goes down or up (see
+ * GlobalRoutingGraph::GetLinkStateVersion): links failed with LinkControlHelper are not part of
+ * any path.  Nodes without GlobalRouter are unreachable.
+ */
+class HopDistanceOracle {
+public:
+  static const uint16_t UNREACHABLE = std::numeric_limits<uint16_t>::max();
+
+  /**
+   * @brief Get the oracle of the current topology
+   *
+   * The oracle is released on Simulator::Destroy.
+   */
+  static HopDistanceOracle&
+  Get();
+
+  /**
+   * @brief Get the number of hops from node @p from to node @p to (node ids)
+   */
+  uint16_t
+  GetDistance(uint32_t from, uint32_t to) const;
+
+  /**
+   * @brief Get the number of hops from node @p from to node @p to
+   */
+  uint16_t
+  GetDistance(Ptr<Node> from, Ptr<Node> to) const;
+
+  /**
+   * @brief Check whether distances are exact, i.e., no landmarks are used
+   */
+  bool
+  IsExact() const;
+
+private:
+  HopDistanceOracle();
+
+  void
+  Build(uint32_t landmarks);
+
+  static HopDistanceOracle&
+  Instance();
+
+  static void
+  Reset();
+
+private:
+  uint32_t m_linkStateVersion;
+  bool m_built;
+  uint32_t m_nodeCount;
+
+  std::vector<uint16_t> m_distances; ///< @brief m_nodeCount x m_nodeCount, if exact
+
+  uint32_t m_requestedLandmarks;
+  uint32_t m_landmarkCount;
+  std::vector<uint16_t> m_fromLandmarks; ///< @brief m_landmarkCount x m_nodeCount
+  std::vector<uint16_t> m_toLandmarks;   ///< @brief m_landmarkCount x m_nodeCount
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_HOP_DISTANCE_ORACLE_H
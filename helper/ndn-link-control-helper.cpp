@@ -30,32 +30,63 @@
 #include "ns3/boolean.h"
 #include "ns3/double.h"
 #include "ns3/pointer.h"
+#include "ns3/simulator.h"
 
 #include "model/ndn-l3-protocol.hpp"
 #include "model/ndn-net-device-face.hpp"
 
 #include "fw/forwarder.hpp"
 
+#include <limits>
+#include <unordered_map>
+
 NS_LOG_COMPONENT_DEFINE("ndn.LinkControlHelper");
 
 namespace ns3 {
 namespace ndn {
 
-void
-LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRate)
+/* PDRM Change */
+namespace {
+
+/**
+ * @brief Handle to one direction of a point-to-point link, from the node owning the face
+ */
+struct LinkHandle
 {
-  NS_LOG_FUNCTION(node1 << node2 << errorRate);
+  shared_ptr<Face> face;
+  Ptr<PointToPointNetDevice> device;
+  Ptr<ErrorModel> errorModel; ///< @brief installed on the device the first time the link fails
+  uint64_t metric;            ///< @brief face metric before the link failed
+  bool isUp;
+};
 
-  NS_ASSERT(node1 != nullptr && node2 != nullptr);
-  NS_ASSERT(errorRate <= 1.0);
+/**
+ * @brief Link handles, by (node ID, peer node ID)
+ */
+std::unordered_map<uint64_t, LinkHandle> g_links;
 
-  Ptr<ndn::L3Protocol> ndn1 = node1->GetObject<ndn::L3Protocol>();
-  Ptr<ndn::L3Protocol> ndn2 = node2->GetObject<ndn::L3Protocol>();
+uint64_t
+getLinkKey(Ptr<Node> node1, Ptr<Node> node2)
+{
+  return (static_cast<uint64_t>(node1->GetId()) << 32) | node2->GetId();
+}
 
-  NS_ASSERT(ndn1 != nullptr && ndn2 != nullptr);
+void
+clearLinks()
+{
+  g_links.clear();
+}
 
-  // iterate over all faces to find the right one
-  for (const auto& face : ndn1->getForwarder()->getFaceTable()) {
+void
+indexLinks(Ptr<Node> node)
+{
+  Ptr<ndn::L3Protocol> ndn = node->GetObject<ndn::L3Protocol>();
+  NS_ASSERT(ndn != nullptr);
+
+  if (g_links.empty())
+    Simulator::ScheduleDestroy(&clearLinks);
+
+  for (const auto& face : ndn->getForwarder()->getFaceTable()) {
     shared_ptr<ndn::NetDeviceFace> ndFace = std::dynamic_pointer_cast<NetDeviceFace>(face);
     if (ndFace == nullptr)
       continue;
@@ -64,48 +95,90 @@ LinkControlHelper::setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRa
     if (nd1 == nullptr)
       continue;
 
-    Ptr<Channel> channel = nd1->GetChannel();
-    if (channel == nullptr)
+    Ptr<PointToPointChannel> ppChannel = DynamicCast<PointToPointChannel>(nd1->GetChannel());
+    if (ppChannel == nullptr)
       continue;
 
-    Ptr<PointToPointChannel> ppChannel = DynamicCast<PointToPointChannel>(channel);
-
     Ptr<NetDevice> nd2 = ppChannel->GetDevice(0);
-    if (nd2->GetNode() == node1)
+    if (nd2->GetNode() == node)
       nd2 = ppChannel->GetDevice(1);
 
-    if (nd2->GetNode() == node2) {
-      ObjectFactory errorFactory("ns3::RateErrorModel");
-      errorFactory.Set("ErrorUnit", StringValue("ERROR_UNIT_PACKET"));
-      errorFactory.Set("ErrorRate", DoubleValue(errorRate));
-      if (errorRate <= 0) {
-        errorFactory.Set("IsEnabled", BooleanValue(false));
-      }
-
-      nd1->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
-      nd2->SetAttribute("ReceiveErrorModel", PointerValue(errorFactory.Create<ErrorModel>()));
-      /* PDRM Change */
-      if (errorRate == 1.0) {
-        face->setMetric(std::numeric_limits<uint16_t>::max() - 1); 
-      }
-      else {
-        face->setMetric(1);
-      }
-      /* PDRM Change */
-      return;
-    }
+    // keep handles already in use, and the first of parallel links
+    g_links.emplace(getLinkKey(node, nd2->GetNode()),
+                    LinkHandle{face, nd1, nullptr, 0, true});
+  }
+}
+
+LinkHandle&
+findLink(Ptr<Node> node1, Ptr<Node> node2)
+{
+  auto link = g_links.find(getLinkKey(node1, node2));
+  if (link == g_links.end()) {
+    // faces may have been created since the node was indexed
+    indexLinks(node1);
+    link = g_links.find(getLinkKey(node1, node2));
+    if (link == g_links.end())
+      NS_FATAL_ERROR("There is no link to fail between the requested nodes");
+  }
+  return link->second;
+}
+
+void
+setLinkDirectionState(LinkHandle& link, bool isUp)
+{
+  // failing a failed link (or bringing up a link that is up) must not touch the saved metric
+  if (link.isUp == isUp)
+    return;
+  link.isUp = isUp;
+
+  if (link.errorModel == nullptr) {
+    Ptr<RateErrorModel> errorModel = CreateObject<RateErrorModel>();
+    errorModel->SetUnit(RateErrorModel::ERROR_UNIT_PACKET);
+    errorModel->SetRate(1.0);
+    link.device->SetReceiveErrorModel(errorModel);
+    link.errorModel = errorModel;
+  }
+
+  if (isUp) {
+    link.errorModel->Disable();
+    link.face->setMetric(link.metric);
+  }
+  else {
+    // the metric may have changed since the link was indexed
+    link.metric = link.face->getMetric();
+    link.errorModel->Enable();
+    link.face->setMetric(std::numeric_limits<uint16_t>::max() - 1);
   }
-  NS_FATAL_ERROR("There is no link to fail between the requested nodes");
+}
+
+} // namespace
+
+void
+LinkControlHelper::setLinkState(Ptr<Node> node1, Ptr<Node> node2, bool isUp)
+{
+  NS_LOG_FUNCTION(node1 << node2 << isUp);
+
+  NS_ASSERT(node1 != nullptr && node2 != nullptr);
+
+  // both ends drop received packets while the link is down
+  setLinkDirectionState(findLink(node1, node2), isUp);
+  setLinkDirectionState(findLink(node2, node1), isUp);
 }
 
 void
 LinkControlHelper::FailLink(Ptr<Node> node1, Ptr<Node> node2)
 {
-  /* PDRM Change */
-  setErrorRate(node1, node2, 1.0);
-  setErrorRate(node2, node1, 1.0);
-  /* PDRM Change */
+  setLinkState(node1, node2, false);
+}
+
+void
+LinkControlHelper::FailLinks(const LinkList& links)
+{
+  for (const auto& link : links) {
+    setLinkState(link.first, link.second, false);
+  }
 }
+/* PDRM Change */
 
 void
 LinkControlHelper::FailLinkByName(const std::string& node1, const std::string& node2)
@@ -113,14 +186,21 @@ LinkControlHelper::FailLinkByName(const std::string& node1, const std::string& n
   FailLink(Names::Find<Node>(node1), Names::Find<Node>(node2));
 }
 
+/* PDRM Change */
 void
 LinkControlHelper::UpLink(Ptr<Node> node1, Ptr<Node> node2)
 {
-  /* PDRM Change */
-  setErrorRate(node1, node2, -0.1); // this will ensure error model is disabled
-  setErrorRate(node2, node1, -0.1); // this will ensure error model is disabled
-  /* PDRM Change */
+  setLinkState(node1, node2, true);
+}
+
+void
+LinkControlHelper::UpLinks(const LinkList& links)
+{
+  for (const auto& link : links) {
+    setLinkState(link.first, link.second, true);
+  }
 }
+/* PDRM Change */
 
 void
 LinkControlHelper::UpLinkByName(const std::string& node1, const std::string& node2)
@@ -25,6 +25,8 @@
 #include "ns3/ptr.h"
 #include "ns3/node.h"
 
+#include <vector>
+
 namespace ns3 {
 namespace ndn {
 
@@ -35,6 +37,13 @@ namespace ndn {
  */
 class LinkControlHelper {
 public:
+  /* PDRM Change */
+  /**
+   * @brief List of links, each given by the two nodes it connects
+   */
+  typedef std::vector<std::pair<Ptr<Node>, Ptr<Node>>> LinkList;
+  /* PDRM Change */
+
   /**
    * @brief Fail NDN link between two nodes
    *
@@ -95,9 +104,29 @@ public:
   static void
   UpLinkByName(const std::string& node1, const std::string& node2);
 
+  /* PDRM Change */
+  /**
+   * @brief Fail NDN links between several pairs of nodes
+   *
+   * Same as calling FailLink for each pair of nodes in @p links
+   */
+  static void
+  FailLinks(const LinkList& links);
+
+  /**
+   * @brief Re-enable NDN links between several pairs of nodes
+   *
+   * Same as calling UpLink for each pair of nodes in @p links
+   */
+  static void
+  UpLinks(const LinkList& links);
+  /* PDRM Change */
+
 private:
+  /* PDRM Change */
   static void
-  setErrorRate(Ptr<Node> node1, Ptr<Node> node2, double errorRate);
+  setLinkState(Ptr<Node> node1, Ptr<Node> node2, bool isUp);
+  /* PDRM Change */
 }; // LinkControlHelper
 
 } // ndn
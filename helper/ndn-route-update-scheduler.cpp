@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-route-update-scheduler.hpp"
+
+#include "helper/ndn-global-routing-helper.hpp"
+
+#include "ns3/log.h"
+#include "ns3/simulator.h"
+#include "ns3/string.h"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.RouteUpdateScheduler");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(RouteUpdateScheduler);
+
+Ptr<RouteUpdateScheduler> RouteUpdateScheduler::s_instance;
+
+TypeId
+RouteUpdateScheduler::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::RouteUpdateScheduler")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      .AddConstructor<RouteUpdateScheduler>()
+
+      .AddAttribute("CoalescingWindow",
+                    "Quiet period after the last request before routes are recomputed",
+                    StringValue("50ms"),
+                    MakeTimeAccessor(&RouteUpdateScheduler::m_window), MakeTimeChecker())
+
+      .AddAttribute("MaxStaleness",
+                    "Maximum delay between the first pending request and the recomputation",
+                    StringValue("200ms"),
+                    MakeTimeAccessor(&RouteUpdateScheduler::m_maxStaleness), MakeTimeChecker())
+
+      .AddTraceSource("Update",
+                      "Routes recomputed: number of requests served, next hop changes, and "
+                      "delay since the first of these requests",
+                      MakeTraceSourceAccessor(&RouteUpdateScheduler::m_updateTrace),
+                      "ns3::ndn::RouteUpdateScheduler::UpdateTraceCallback");
+
+  return tid;
+}
+
+Ptr<RouteUpdateScheduler>
+RouteUpdateScheduler::Get()
+{
+  if (s_instance == 0) {
+    s_instance = CreateObject<RouteUpdateScheduler>();
+    Simulator::ScheduleDestroy(&RouteUpdateScheduler::DestroyInstance);
+  }
+  return s_instance;
+}
+
+void
+RouteUpdateScheduler::DestroyInstance()
+{
+  if (s_instance != 0) {
+    s_instance->Dispose();
+    s_instance = 0;
+  }
+}
+
+RouteUpdateScheduler::RouteUpdateScheduler()
+  : m_requests(0)
+  , m_fullUpdate(false)
+{
+}
+
+void
+RouteUpdateScheduler::DoDispose()
+{
+  Simulator::Remove(m_updateEvent);
+  m_requests = 0;
+  m_fullUpdate = false;
+  m_dirtyPrefixes.clear();
+  m_onUpdated.clear();
+
+  Object::DoDispose();
+}
+
+void
+RouteUpdateScheduler::RequestUpdate()
+{
+  m_fullUpdate = true;
+  ScheduleUpdate();
+}
+
+void
+RouteUpdateScheduler::RequestUpdate(const std::function<void()>& onUpdated)
+{
+  m_onUpdated.push_back(onUpdated);
+  RequestUpdate();
+}
+
+void
+RouteUpdateScheduler::RequestUpdate(const Name& prefix)
+{
+  m_dirtyPrefixes.insert(prefix);
+  ScheduleUpdate();
+}
+
+void
+RouteUpdateScheduler::RequestUpdate(const Name& prefix, const std::function<void()>& onUpdated)
+{
+  m_onUpdated.push_back(onUpdated);
+  RequestUpdate(prefix);
+}
+
+void
+RouteUpdateScheduler::ScheduleUpdate()
+{
+  if (m_requests == 0)
+    m_firstRequest = Simulator::Now();
+  m_requests++;
+
+  Time deadline = std::max(m_firstRequest + m_maxStaleness, Simulator::Now());
+  Time next = std::min(Simulator::Now() + m_window, deadline);
+
+  if (m_updateEvent.IsRunning()) {
+    if (Simulator::Now() + Simulator::GetDelayLeft(m_updateEvent) == next)
+      return;
+    Simulator::Remove(m_updateEvent);
+  }
+
+  NS_LOG_DEBUG("Routes dirty, " << m_requests << " request(s) pending, update at " << next);
+  m_updateEvent = Simulator::Schedule(next - Simulator::Now(), &RouteUpdateScheduler::Update, this);
+}
+
+void
+RouteUpdateScheduler::Flush()
+{
+  if (m_updateEvent.IsRunning()) {
+    Simulator::Remove(m_updateEvent);
+    Update();
+  }
+}
+
+bool
+RouteUpdateScheduler::IsPending() const
+{
+  return m_updateEvent.IsRunning();
+}
+
+void
+RouteUpdateScheduler::Update()
+{
+  uint32_t requests = m_requests;
+  Time staleness = Simulator::Now() - m_firstRequest;
+  std::vector<std::function<void()>> onUpdated;
+  onUpdated.swap(m_onUpdated);
+  std::set<Name> prefixes;
+  prefixes.swap(m_dirtyPrefixes);
+  bool fullUpdate = m_fullUpdate;
+  m_fullUpdate = false;
+  m_requests = 0;
+
+  uint32_t changes = 0;
+  if (fullUpdate) {
+    changes = GlobalRoutingHelper::CalculateRoutesIncremental();
+  }
+  else {
+    // only origins changed: one reverse shortest path tree per origin of each dirty prefix
+    for (const auto& prefix : prefixes) {
+      changes += GlobalRoutingHelper::CalculateRoutes(prefix.toUri());
+    }
+  }
+  GlobalRoutingHelper::PrintFIBs();
+
+  NS_LOG_DEBUG("Routes recomputed for " << requests << " request(s), " << changes << " change(s)");
+  m_updateTrace(requests, changes, staleness);
+
+  for (const auto& callback : onUpdated) {
+    callback();
+  }
+}
+
+} // namespace ndn
+} // namespace ns3
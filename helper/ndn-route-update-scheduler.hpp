@@ -0,0 +1,140 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ROUTE_UPDATE_SCHEDULER_H
+#define NDN_ROUTE_UPDATE_SCHEDULER_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+#include "ns3/event-id.h"
+#include "ns3/traced-callback.h"
+
+#include <functional>
+#include <set>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Global service that coalesces route recomputation requests
+ *
+ * Applications that change origins or links mark the routes dirty with RequestUpdate instead of
+ * calling GlobalRoutingHelper::CalculateRoutes themselves.  The first request opens a coalescing
+ * window, every further request pushes the recomputation to the end of a new window, and the
+ * recomputation never happens later than MaxStaleness after the first pending request.  All
+ * requests pending at that point are served by a single GlobalRoutingHelper::CalculateRoutesIncremental.
+ *
+ * Applications that only changed the origins of a prefix request an update of that prefix.  If
+ * nothing else is pending when the window closes, only the routes to the dirty prefixes are
+ * recalculated, with GlobalRoutingHelper::CalculateRoutes(prefix).
+ *
+ * Attributes are set on the shared instance returned by RouteUpdateScheduler::Get, or through
+ * Config::SetDefault before the first request.
+ */
+class RouteUpdateScheduler : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  /**
+   * @brief Get the simulation-wide scheduler, creating it on first use
+   *
+   * The instance is released on Simulator::Destroy.
+   */
+  static Ptr<RouteUpdateScheduler>
+  Get();
+
+  RouteUpdateScheduler();
+
+  /**
+   * @brief Mark routes dirty and schedule a coalesced recomputation
+   */
+  void
+  RequestUpdate();
+
+  /**
+   * @brief Mark routes dirty and call @p onUpdated once routes have been recomputed
+   */
+  void
+  RequestUpdate(const std::function<void()>& onUpdated);
+
+  /**
+   * @brief Mark routes to @p prefix dirty, e.g., after an origin was added or removed
+   */
+  void
+  RequestUpdate(const Name& prefix);
+
+  /**
+   * @brief Mark routes to @p prefix dirty and call @p onUpdated once they have been recomputed
+   */
+  void
+  RequestUpdate(const Name& prefix, const std::function<void()>& onUpdated);
+
+  /**
+   * @brief Recompute routes right away if any request is pending
+   */
+  void
+  Flush();
+
+  /**
+   * @brief Check whether a recomputation is pending
+   */
+  bool
+  IsPending() const;
+
+  typedef void (*UpdateTraceCallback)(uint32_t requests, uint32_t changes, Time staleness);
+
+protected:
+  virtual void
+  DoDispose();
+
+private:
+  void
+  ScheduleUpdate();
+
+  void
+  Update();
+
+  static void
+  DestroyInstance();
+
+private:
+  Time m_window;
+  Time m_maxStaleness;
+
+  EventId m_updateEvent;
+  Time m_firstRequest;
+  uint32_t m_requests;
+  bool m_fullUpdate;
+  std::set<Name> m_dirtyPrefixes;
+  std::vector<std::function<void()>> m_onUpdated;
+
+  TracedCallback<uint32_t, uint32_t, Time> m_updateTrace;
+
+  static Ptr<RouteUpdateScheduler> s_instance;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ROUTE_UPDATE_SCHEDULER_H
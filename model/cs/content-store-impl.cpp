@@ -25,6 +25,9 @@
 #include "../../utils/trie/lfu-policy.hpp"
 #include "../../utils/trie/multi-policy.hpp"
 #include "../../utils/trie/aggregate-stats-policy.hpp"
+/* PDRM Change */
+#include "../../utils/trie/radix-trie.hpp"
+/* PDRM Change */
 
 #define NS_OBJECT_ENSURE_REGISTERED_TEMPL(type, templ)                                             \
   static struct X##type##templ##RegistrationClass {                                                \
@@ -90,6 +93,26 @@ NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, FifoWithCountsTraits);
 template class ContentStoreImpl<LfuWithCountsTraits>;
 NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, LfuWithCountsTraits);
 
+/* PDRM Change */
+// same replacement policies on top of the path-compressed trie
+typedef radix_policy_traits<lru_policy_traits> RadixLruTraits;
+typedef radix_policy_traits<random_policy_traits> RadixRandomTraits;
+typedef radix_policy_traits<fifo_policy_traits> RadixFifoTraits;
+typedef radix_policy_traits<lfu_policy_traits> RadixLfuTraits;
+
+template class ContentStoreImpl<RadixLruTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RadixLruTraits);
+
+template class ContentStoreImpl<RadixRandomTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RadixRandomTraits);
+
+template class ContentStoreImpl<RadixFifoTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RadixFifoTraits);
+
+template class ContentStoreImpl<RadixLfuTraits>;
+NS_OBJECT_ENSURE_REGISTERED_TEMPL(ContentStoreImpl, RadixLfuTraits);
+/* PDRM Change */
+
 #ifdef DOXYGEN
 // /**
 //  * \brief Content Store implementing LRU cache replacement policy
@@ -114,6 +137,14 @@ class Random : public ContentStoreImpl<random_policy_traits> {
  */
 class Lfu : public ContentStoreImpl<lfu_policy_traits> {
 };
+
+/**
+ * \brief Content Store implementing LRU cache replacement policy on a path-compressed trie
+ *
+ * RadixFifo, RadixRandom and RadixLfu are the same for the other policies
+ */
+class RadixLru : public ContentStoreImpl<radix_policy_traits<lru_policy_traits>> {
+};
 #endif
 
 } // namespace cs
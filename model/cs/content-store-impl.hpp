@@ -30,6 +30,7 @@
 #include "ns3/log.h"
 #include "ns3/uinteger.h"
 #include "ns3/string.h"
+#include "ns3/traced-value.h"
 
 #include "../../utils/trie/trie-with-policy.hpp"
 
@@ -85,24 +86,30 @@ class ContentStoreImpl
       trie_with_policy<Name,
                        ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
                                                             Entry>,
-                       Policy> {
+                       Policy, ndnSIM::slab_allocator> {
 public:
   typedef ndnSIM::
     trie_with_policy<Name, ndnSIM::smart_pointer_payload_traits<EntryImpl<ContentStoreImpl<Policy>>,
                                                                 Entry>,
-                     Policy> super;
+                     Policy, ndnSIM::slab_allocator> super;
 
   typedef EntryImpl<ContentStoreImpl<Policy>> entry;
 
   static TypeId
   GetTypeId();
 
-  ContentStoreImpl(){};
+  ContentStoreImpl()
+    : m_bytesUsed(0)
+  {
+    /* PDRM Change */
+    super::set_payload_bytes_getter(&ContentStoreImpl<Policy>::GetEntryBytes);
+    /* PDRM Change */
+  };
   virtual ~ContentStoreImpl(){};
 
   // from ContentStore
 
-  virtual inline shared_ptr<Data>
+  virtual inline LookupResult
   Lookup(shared_ptr<const Interest> interest);
 
   virtual inline bool
@@ -140,6 +147,15 @@ public:
 public:
   typedef void (*CsEntryCallback)(Ptr<const Entry>);
 
+protected:
+  /* PDRM Change */
+  /**
+   * @brief Refresh BytesUsed trace after entries have been added or removed
+   */
+  void
+  UpdateBytesUsed();
+  /* PDRM Change */
+
 private:
   void
   SetMaxSize(uint32_t maxSize);
@@ -147,12 +163,28 @@ private:
   uint32_t
   GetMaxSize() const;
 
+  /* PDRM Change */
+  void
+  SetMaxBytes(uint32_t maxBytes);
+
+  uint32_t
+  GetMaxBytes() const;
+
+  static std::size_t
+  GetEntryBytes(typename super::const_iterator item);
+  /* PDRM Change */
+
 private:
   static LogComponent g_log; ///< @brief Logging variable
 
   /// @brief trace of for entry additions (fired every time entry is successfully added to the
   /// cache): first parameter is pointer to the CS entry
   TracedCallback<Ptr<const Entry>> m_didAddEntry;
+
+  /* PDRM Change */
+  /// @brief total wire size of cached Data packets
+  TracedValue<uint32_t> m_bytesUsed;
+  /* PDRM Change */
 };
 
 //////////////////////////////////////////
@@ -176,11 +208,24 @@ ContentStoreImpl<Policy>::GetTypeId()
                     StringValue("100"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxSize,
                                                              &ContentStoreImpl<Policy>::SetMaxSize),
                     MakeUintegerChecker<uint32_t>())
+      /* PDRM Change */
+      .AddAttribute("MaxBytes",
+                    "Set maximum total wire size of Data packets in ContentStore. If 0, limit is "
+                    "not enforced",
+                    StringValue("0"), MakeUintegerAccessor(&ContentStoreImpl<Policy>::GetMaxBytes,
+                                                           &ContentStoreImpl<Policy>::SetMaxBytes),
+                    MakeUintegerChecker<uint32_t>())
+      /* PDRM Change */
 
       .AddTraceSource("DidAddEntry",
                       "Trace fired every time entry is successfully added to the cache",
                       MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_didAddEntry),
-                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback");
+                      "ns3::ndn::cs::ContentStoreImpl::CsEntryCallback")
+      /* PDRM Change */
+      .AddTraceSource("BytesUsed", "Total wire size of Data packets in the cache",
+                      MakeTraceSourceAccessor(&ContentStoreImpl<Policy>::m_bytesUsed),
+                      "ns3::TracedValueCallback::Uint32");
+      /* PDRM Change */
 
   return tid;
 }
@@ -202,7 +247,7 @@ private:
 };
 
 template<class Policy>
-shared_ptr<Data>
+LookupResult
 ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
 {
   NS_LOG_FUNCTION(this << interest->getName());
@@ -219,12 +264,13 @@ ContentStoreImpl<Policy>::Lookup(shared_ptr<const Interest> interest)
   if (node != this->end()) {
     this->m_cacheHitsTrace(interest, node->payload()->GetData());
 
-    shared_ptr<Data> copy = make_shared<Data>(*node->payload()->GetData());
-    return copy;
+    /* PDRM Change */
+    return node->payload()->GetData();
+    /* PDRM Change */
   }
   else {
     this->m_cacheMissesTrace(interest);
-    return 0;
+    return nullptr;
   }
 }
 
@@ -236,6 +282,9 @@ ContentStoreImpl<Policy>::Add(shared_ptr<const Data> data)
 
   Ptr<entry> newEntry = Create<entry>(this, data);
   std::pair<typename super::iterator, bool> result = super::insert(data->getName(), newEntry);
+  /* PDRM Change */
+  UpdateBytesUsed(); // entries may have been evicted even if this one is not added
+  /* PDRM Change */
 
   if (result.first != super::end()) {
     if (result.second) {
@@ -278,6 +327,36 @@ ContentStoreImpl<Policy>::GetMaxSize() const
   return this->getPolicy().get_max_size();
 }
 
+/* PDRM Change */
+template<class Policy>
+void
+ContentStoreImpl<Policy>::SetMaxBytes(uint32_t maxBytes)
+{
+  this->getPolicy().set_max_bytes(maxBytes);
+}
+
+template<class Policy>
+uint32_t
+ContentStoreImpl<Policy>::GetMaxBytes() const
+{
+  return this->getPolicy().get_max_bytes();
+}
+
+template<class Policy>
+std::size_t
+ContentStoreImpl<Policy>::GetEntryBytes(typename super::const_iterator item)
+{
+  return item->payload()->GetData()->wireEncode().size();
+}
+
+template<class Policy>
+void
+ContentStoreImpl<Policy>::UpdateBytesUsed()
+{
+  m_bytesUsed = super::get_bytes();
+}
+/* PDRM Change */
+
 template<class Policy>
 uint32_t
 ContentStoreImpl<Policy>::GetSize() const
@@ -49,11 +49,11 @@ Nocache::~Nocache()
 {
 }
 
-shared_ptr<Data>
+LookupResult
 Nocache::Lookup(shared_ptr<const Interest> interest)
 {
   this->m_cacheMissesTrace(interest);
-  return 0;
+  return nullptr;
 }
 
 bool
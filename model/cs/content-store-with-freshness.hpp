@@ -161,6 +161,9 @@ ContentStoreWithFreshness<Policy>::CleanExpired()
     else
       break; // nothing else to do. All later records will not be stale
   }
+  /* PDRM Change */
+  this->UpdateBytesUsed();
+  /* PDRM Change */
   // NS_LOG_LOGIC ("<< Cleaning: Total number of items:" << this->getPolicy ().size () << ", items
   // with freshness: " << freshness.size ());
 
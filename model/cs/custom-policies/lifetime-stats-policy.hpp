@@ -82,6 +82,7 @@ struct lifetime_stats_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
         , m_willRemoveEntry(0)
       {
       }
@@ -137,6 +138,21 @@ struct lifetime_stats_policy_traits {
         return max_size_;
       }
 
+      /* PDRM Change */
+      // not enforced by this policy, kept for multi_policy
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+      /* PDRM Change */
+
       void
       set_traced_callback(
         TracedCallback<typename parent_trie::payload_traits::const_base_type, Time>* callback)
@@ -151,6 +167,7 @@ struct lifetime_stats_policy_traits {
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
 
       TracedCallback<typename parent_trie::payload_traits::const_base_type, Time>*
         m_willRemoveEntry;
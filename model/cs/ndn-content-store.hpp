@@ -89,6 +89,75 @@ private:
   shared_ptr<const Data> m_data; ///< \brief non-modifiable Data
 };
 
+/* PDRM Change */
+/**
+ * @ingroup ndn-cs
+ * @brief Data found by ContentStore::Lookup, shared with the content store
+ *
+ * Converts to shared_ptr<const Data> without copying the Data.  Conversion to shared_ptr<Data>
+ * is kept for callers that modify the returned Data: they get a private copy, as before.
+ */
+class LookupResult {
+public:
+  LookupResult(std::nullptr_t = nullptr)
+  {
+  }
+
+  LookupResult(shared_ptr<const Data> data)
+    : m_data(std::move(data))
+  {
+  }
+
+  shared_ptr<const Data>
+  get() const
+  {
+    return m_data;
+  }
+
+  operator shared_ptr<const Data>() const
+  {
+    return m_data;
+  }
+
+  operator shared_ptr<Data>() const
+  {
+    return m_data == nullptr ? nullptr : make_shared<Data>(*m_data);
+  }
+
+  const Data&
+  operator*() const
+  {
+    return *m_data;
+  }
+
+  const Data*
+  operator->() const
+  {
+    return m_data.get();
+  }
+
+  explicit operator bool() const
+  {
+    return m_data != nullptr;
+  }
+
+  friend bool
+  operator==(const LookupResult& result, std::nullptr_t)
+  {
+    return result.m_data == nullptr;
+  }
+
+  friend bool
+  operator!=(const LookupResult& result, std::nullptr_t)
+  {
+    return result.m_data != nullptr;
+  }
+
+private:
+  shared_ptr<const Data> m_data;
+};
+/* PDRM Change */
+
 } // namespace cs
 
 /**
@@ -119,8 +188,10 @@ public:
    *
    * If an entry is found, it is promoted to the top of most recent
    * used entries index, \see m_contentStore
+   *
+   * The returned Data is the one stored in the content store, not a copy
    */
-  virtual shared_ptr<Data>
+  virtual cs::LookupResult
   Lookup(shared_ptr<const Interest> interest) = 0;
 
   /**
@@ -207,12 +278,14 @@ ContentStore::GetContentStore(Ptr<Object> node)
 
 #include <boost/functional/hash.hpp>
 namespace boost {
+/* PDRM Change */
 inline std::size_t
-hash_value(const ::ndn::name::Component component)
+hash_value(const ::ndn::name::Component& component)
 {
-  return boost::hash_range(component.wireEncode().wire(),
-                           component.wireEncode().wire() + component.wireEncode().size());
+  const ::ndn::Block& wire = component.wireEncode();
+  return boost::hash_range(wire.wire(), wire.wire() + wire.size());
 }
+/* PDRM Change */
 }
 
 #endif // NDN_CONTENT_STORE_H
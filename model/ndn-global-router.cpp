@@ -23,25 +23,62 @@
 #include "model/ndn-face.hpp"
 
 #include "ns3/channel.h"
+#include "ns3/boolean.h"
+#include "ns3/simulator.h"
+#include "ns3/log.h"
+#include "ns3/trace-source-accessor.h"
+
+#include "ns3/ndnSIM/NFD/daemon/fw/forwarder.hpp"
+
+#include <algorithm>
+
+NS_LOG_COMPONENT_DEFINE("ndn.GlobalRouter");
 
 namespace ns3 {
 namespace ndn {
 
 uint32_t GlobalRouter::m_idCounter = 0;
+uint32_t GlobalRouter::m_topologyVersion = 0;
+std::unordered_map<Name, std::map<uint32_t, Ptr<GlobalRouter>>, NameHash>
+  GlobalRouter::m_routeHolders;
 
 NS_OBJECT_ENSURE_REGISTERED(GlobalRouter);
 
 TypeId
 GlobalRouter::GetTypeId()
 {
-  static TypeId tid = TypeId("ns3::ndn::GlobalRouter").SetGroupName("Ndn").SetParent<Object>();
+  static TypeId tid =
+    TypeId("ns3::ndn::GlobalRouter")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+      /* PDRM Change */
+      .AddAttribute("AggregateRoutes",
+                    "Leave routes out of the FIB when a less specific entry yields the same "
+                    "next hops.  Forwarding of every name is unchanged",
+                    BooleanValue(false), MakeBooleanAccessor(&GlobalRouter::m_aggregateRoutes),
+                    MakeBooleanChecker())
+      .AddAttribute("CoverSiblings",
+                    "With AggregateRoutes, also cover sibling routes sharing next hops by an "
+                    "entry for their parent prefix.  Names under the parent that have no route "
+                    "(e.g., an object no longer announced) are then forwarded over the shared "
+                    "next hops instead of being dropped",
+                    BooleanValue(false), MakeBooleanAccessor(&GlobalRouter::m_coverSiblings),
+                    MakeBooleanChecker())
+      .AddTraceSource("AggregatedRoutes",
+                      "Number of routes and of FIB entries installed for them, after aggregation",
+                      MakeTraceSourceAccessor(&GlobalRouter::m_aggregatedRoutes),
+                      "ns3::ndn::GlobalRouter::AggregatedRoutesCallback");
+  /* PDRM Change */
   return tid;
 }
 
 GlobalRouter::GlobalRouter()
+  : m_aggregateRoutes(false)
+  , m_coverSiblings(false)
 {
   m_id = m_idCounter;
   m_idCounter++;
+  m_topologyVersion++;
 }
 
 void
@@ -69,29 +106,32 @@ void
 GlobalRouter::AddLocalPrefix(shared_ptr<Name> prefix)
 {
   m_localPrefixes.push_back(prefix);
+  m_localPrefixCounts[*prefix]++;
 }
 
 /* PDRM Change */
 void
 GlobalRouter::RemoveLocalPrefix(shared_ptr<Name> prefix)
 {
-/*
-  std::cout << m_localPrefixes.size() << std::endl;
-  for (std::list<shared_ptr<Name> >::iterator it = m_localPrefixes.begin(); it != m_localPrefixes.end(); ++it) {
-    std::cout << prefix->toUri() << " " << (*it)->toUri() << std::endl;
-    if (prefix->toUri() == (*it)->toUri())
-      m_localPrefixes.erase(it);
-  }
-  std::cout << m_localPrefixes.size() << std::endl;
-*/
-  for (auto &entry : m_localPrefixes) {
-    if (prefix->toUri() == entry->toUri()) {
-      m_localPrefixes.remove(entry);
-      //std::cout << "Removed: " << entry->toUri() << std::endl;
+  auto count = m_localPrefixCounts.find(*prefix);
+  if (count == m_localPrefixCounts.end())
+    return;
+
+  if (--count->second == 0)
+    m_localPrefixCounts.erase(count);
+
+  for (auto entry = m_localPrefixes.begin(); entry != m_localPrefixes.end(); entry++) {
+    if (**entry == *prefix) {
+      m_localPrefixes.erase(entry);
       return;
     }
   }
-    
+}
+
+bool
+GlobalRouter::HasLocalPrefix(const Name& prefix) const
+{
+  return m_localPrefixCounts.find(prefix) != m_localPrefixCounts.end();
 }
 /* PDRM Change */
 
@@ -99,6 +139,7 @@ void
 GlobalRouter::AddIncidency(shared_ptr<Face> face, Ptr<GlobalRouter> gr)
 {
   m_incidencies.push_back(std::make_tuple(this, face, gr));
+  m_topologyVersion++;
 }
 
 GlobalRouter::IncidencyList&
@@ -113,10 +154,326 @@ GlobalRouter::GetLocalPrefixes() const
   return m_localPrefixes;
 }
 
+/* PDRM Change */
+GlobalRouter::DistanceList&
+GlobalRouter::GetDistances()
+{
+  return m_distances;
+}
+
+std::vector<uint16_t>&
+GlobalRouter::GetIncidencyMetrics()
+{
+  return m_incidencyMetrics;
+}
+
+GlobalRouter::InstalledRouteMap&
+GlobalRouter::GetInstalledRoutes()
+{
+  return m_installedRoutes;
+}
+
+uint32_t
+GlobalRouter::GetTopologyVersion()
+{
+  return m_topologyVersion;
+}
+
+/**
+ * @brief Check whether two sets of next hops are equal, regardless of their order
+ */
+static bool
+IsSameRoutes(const GlobalRouter::RouteActionList& a, const GlobalRouter::RouteActionList& b)
+{
+  if (a.size() != b.size())
+    return false;
+  for (const auto& route : a) {
+    if (std::find(b.begin(), b.end(), route) == b.end())
+      return false;
+  }
+  return true;
+}
+
+void
+GlobalRouter::AddRoute(const Name& prefix, shared_ptr<Face> face, uint64_t cost)
+{
+  RouteActionList& routes = m_routedPrefixes[prefix];
+  bool isNew = routes.empty();
+  if (isNew) {
+    m_routeHolders[prefix][m_id] = this;
+    if (prefix.size() > 0)
+      m_routedChildren[prefix.getPrefix(-1)].insert(prefix);
+  }
+
+  auto route = std::find_if(routes.begin(), routes.end(),
+                            [&face] (const RouteActionList::value_type& route) {
+                              return route.first == face;
+                            });
+  if (route == routes.end())
+    routes.push_back(std::make_pair(face, cost));
+  else
+    route->second = cost;
+
+  if (!m_aggregateRoutes) {
+    m_ndn->addNextHop(prefix, face, cost);
+    return;
+  }
+
+  // cover entries below a new route would shadow it for names it does not route
+  if (isNew) {
+    for (auto cover = m_coverEntries.lower_bound(prefix);
+         cover != m_coverEntries.end() && prefix.isPrefixOf(*cover);) {
+      Disaggregate(*cover++);
+    }
+  }
+
+  // children left out of the FIB relied on the previous next hops of the prefix
+  Disaggregate(prefix);
+  InstallFibEntry(prefix, routes);
+
+  if (prefix.size() > 0)
+    Disaggregate(prefix.getPrefix(-1));
+}
+
+void
+GlobalRouter::RemoveRoutes(const Name& prefix)
+{
+  auto routes = m_routedPrefixes.find(prefix);
+  if (routes == m_routedPrefixes.end()) {
+    // not a route (a cover entry stays, as it does not stand for any route)
+    if (m_fibEntries.count(prefix) == 0)
+      m_ndn->removeNextHops(prefix);
+    return;
+  }
+  m_routedPrefixes.erase(routes);
+
+  // the index may have been reset by GlobalRouter::clear
+  auto holders = m_routeHolders.find(prefix);
+  if (holders != m_routeHolders.end()) {
+    holders->second.erase(m_id);
+    if (holders->second.empty())
+      m_routeHolders.erase(holders);
+  }
+
+  if (prefix.size() > 0) {
+    auto siblings = m_routedChildren.find(prefix.getPrefix(-1));
+    siblings->second.erase(prefix);
+    if (siblings->second.empty())
+      m_routedChildren.erase(siblings);
+  }
+
+  if (!m_aggregateRoutes) {
+    m_ndn->removeNextHops(prefix);
+    return;
+  }
+
+  Disaggregate(prefix);
+  InstallFibEntry(prefix, RouteActionList());
+
+  if (prefix.size() > 0)
+    Disaggregate(prefix.getPrefix(-1));
+}
+
+const GlobalRouter::RoutedPrefixMap&
+GlobalRouter::GetRoutedPrefixes() const
+{
+  return m_routedPrefixes;
+}
+
+const GlobalRouter::RoutedPrefixMap&
+GlobalRouter::GetFibEntries() const
+{
+  return m_aggregateRoutes ? m_fibEntries : m_routedPrefixes;
+}
+
+const GlobalRouter::RouteActionList*
+GlobalRouter::FindRoutes(const Name& prefix) const
+{
+  auto routes = m_routedPrefixes.find(prefix);
+  return routes != m_routedPrefixes.end() ? &routes->second : nullptr;
+}
+
+void
+GlobalRouter::InstallFibEntry(const Name& prefix, const RouteActionList& routes)
+{
+  auto entry = m_fibEntries.find(prefix);
+
+  if (routes.empty()) {
+    if (entry != m_fibEntries.end()) {
+      m_ndn->removeNextHops(prefix);
+      m_fibEntries.erase(entry);
+    }
+    return;
+  }
+
+  if (entry != m_fibEntries.end()) {
+    if (IsSameRoutes(entry->second, routes))
+      return;
+    m_ndn->removeNextHops(prefix);
+  }
+
+  for (const auto& route : routes) {
+    m_ndn->addNextHop(prefix, route.first, route.second);
+  }
+  m_fibEntries[prefix] = routes;
+}
+
+void
+GlobalRouter::Disaggregate(const Name& parent)
+{
+  // every route of the group gets its own FIB entry back, which is always correct
+  auto children = m_routedChildren.find(parent);
+  if (children != m_routedChildren.end()) {
+    for (const auto& child : children->second) {
+      InstallFibEntry(child, m_routedPrefixes[child]);
+    }
+  }
+
+  if (m_coverEntries.erase(parent) > 0 && FindRoutes(parent) == nullptr)
+    InstallFibEntry(parent, RouteActionList());
+
+  m_dirtyGroups.insert(parent);
+  if (!m_aggregationEvent.IsRunning())
+    m_aggregationEvent = Simulator::ScheduleNow(&GlobalRouter::AggregateRoutes, this);
+}
+
+bool
+GlobalRouter::CanCover(const Name& parent) const
+{
+  if (parent.empty())
+    return false;
+
+  // a cover entry must not take names away from a less specific route or a local prefix, nor
+  // replace or shadow a FIB entry that was not installed by this router (e.g., a default route
+  // added by StackHelper or a route added with FibHelper)
+  nfd::Fib& fib = m_ndn->getForwarder()->getFib();
+  for (size_t length = 0; length <= parent.size(); length++) {
+    Name prefix = parent.getPrefix(length);
+    if (FindRoutes(prefix) != nullptr || HasLocalPrefix(prefix))
+      return false;
+
+    shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch(prefix);
+    if (entry != nullptr && entry->hasNextHops() && m_fibEntries.count(prefix) == 0)
+      return false;
+  }
+
+  return true;
+}
+
+void
+GlobalRouter::Aggregate(const Name& parent)
+{
+  auto children = m_routedChildren.find(parent);
+  if (children == m_routedChildren.end())
+    return;
+
+  const RouteActionList* cover = FindRoutes(parent);
+
+  // without a route of its own, the parent can cover the next hops most of its children share;
+  // this also captures names under the parent that no child routes, hence opt-in
+  RouteActionList shared;
+  if (m_coverSiblings && cover == nullptr && children->second.size() > 1 && CanCover(parent)) {
+    typedef std::vector<std::pair<uint64_t, uint32_t>> RouteKey; // face ID, cost
+    std::map<RouteKey, uint32_t> counts;
+    uint32_t best = 1;
+    for (const auto& child : children->second) {
+      const RouteActionList& routes = m_routedPrefixes[child];
+      RouteKey key;
+      for (const auto& route : routes) {
+        key.push_back(std::make_pair(route.first->getId(), route.second));
+      }
+      std::sort(key.begin(), key.end());
+
+      uint32_t count = ++counts[key];
+      if (count > best) {
+        best = count;
+        shared = routes;
+      }
+    }
+
+    if (!shared.empty()) {
+      cover = &shared;
+      m_coverEntries.insert(parent);
+      InstallFibEntry(parent, shared);
+    }
+  }
+
+  if (cover == nullptr)
+    return;
+
+  // exceptions keep their own FIB entry
+  for (const auto& child : children->second) {
+    const RouteActionList& routes = m_routedPrefixes[child];
+    InstallFibEntry(child, IsSameRoutes(routes, *cover) ? RouteActionList() : routes);
+  }
+}
+
+void
+GlobalRouter::AggregateRoutes()
+{
+  if (!m_aggregateRoutes)
+    return;
+
+  m_aggregationEvent.Cancel();
+
+  std::set<Name> groups;
+  groups.swap(m_dirtyGroups);
+  for (const auto& group : groups) {
+    Aggregate(group);
+  }
+
+  NS_LOG_DEBUG("Routes: " << m_routedPrefixes.size() << ", FIB entries: " << m_fibEntries.size());
+  m_aggregatedRoutes(m_routedPrefixes.size(), m_fibEntries.size());
+}
+
+std::vector<Ptr<GlobalRouter>>
+GlobalRouter::GetRouteHolders(const Name& prefix)
+{
+  std::vector<Ptr<GlobalRouter>> routers;
+
+  auto holders = m_routeHolders.find(prefix);
+  if (holders != m_routeHolders.end()) {
+    for (const auto& holder : holders->second) {
+      routers.push_back(holder.second);
+    }
+  }
+  return routers;
+}
+
+void
+GlobalRouter::DoDispose()
+{
+  for (const auto& routed : m_routedPrefixes) {
+    auto holders = m_routeHolders.find(routed.first);
+    if (holders == m_routeHolders.end())
+      continue; // index reset by GlobalRouter::clear
+
+    holders->second.erase(m_id);
+    if (holders->second.empty())
+      m_routeHolders.erase(holders);
+  }
+  m_routedPrefixes.clear();
+  m_fibEntries.clear();
+  m_routedChildren.clear();
+  m_coverEntries.clear();
+  m_dirtyGroups.clear();
+  m_aggregationEvent.Cancel();
+
+  m_distances.clear();
+  m_incidencyMetrics.clear();
+  m_installedRoutes.clear();
+  m_topologyVersion++;
+
+  Object::DoDispose();
+}
+/* PDRM Change */
+
 void
 GlobalRouter::clear()
 {
   m_idCounter = 0;
+  m_topologyVersion++;
+  m_routeHolders.clear();
 }
 
 } // namespace ndn
@@ -22,12 +22,19 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 #include "ns3/ndnSIM/model/ndn-face.hpp"
+#include "ns3/ndnSIM/utils/ndn-name-hash.hpp"
 
 #include "ns3/object.h"
 #include "ns3/ptr.h"
+#include "ns3/traced-callback.h"
+#include "ns3/event-id.h"
 
 #include <list>
+#include <map>
+#include <set>
 #include <tuple>
+#include <unordered_map>
+#include <vector>
 
 namespace ns3 {
 
@@ -56,6 +63,31 @@ public:
    */
   typedef std::list<shared_ptr<Name>> LocalPrefixList;
 
+  /* PDRM Change */
+  /**
+   * @brief Shortest path toward another router: first-hop face, path metric, and path delay
+   */
+  typedef std::tuple<shared_ptr<Face>, uint32_t, double> Distance;
+  /**
+   * @brief Shortest paths from this router, indexed by GlobalRouter ID
+   */
+  typedef std::vector<Distance> DistanceList;
+  /**
+   * @brief FIB updates applied for a prefix, in application order
+   *
+   * Each entry is a (face, cost) pair; a null face denotes removal of all next hops
+   */
+  typedef std::vector<std::pair<shared_ptr<Face>, uint32_t>> RouteActionList;
+  /**
+   * @brief FIB updates applied by the routing helper on this router, per prefix
+   */
+  typedef std::map<Name, RouteActionList> InstalledRouteMap;
+  /**
+   * @brief Next hops (face, cost) installed through AddRoute, per prefix
+   */
+  typedef std::unordered_map<Name, RouteActionList, NameHash> RoutedPrefixMap;
+  /* PDRM Change */
+
   /**
    * \brief Interface ID
    *
@@ -89,8 +121,17 @@ public:
   AddLocalPrefix(shared_ptr<Name> prefix);
 
   /* PDRM Change */
+  /**
+   * @brief Remove a locally exported prefix (one occurrence, if added several times)
+   */
   void
   RemoveLocalPrefix(shared_ptr<Name> prefix);
+
+  /**
+   * @brief Check whether @p prefix is exported by this router
+   */
+  bool
+  HasLocalPrefix(const Name& prefix) const;
   /* PDRM Change */
 
   /**
@@ -113,6 +154,80 @@ public:
   const LocalPrefixList&
   GetLocalPrefixes() const;
 
+  /* PDRM Change */
+  /**
+   * @brief Get shortest paths cached by the last route computation rooted at this router
+   */
+  DistanceList&
+  GetDistances();
+
+  /**
+   * @brief Get edge metrics (in the order of GetIncidencies ()) seen by the last route computation
+   */
+  std::vector<uint16_t>&
+  GetIncidencyMetrics();
+
+  /**
+   * @brief Get FIB updates applied on this router by the last route computation
+   */
+  InstalledRouteMap&
+  GetInstalledRoutes();
+
+  /**
+   * @brief Get a counter that changes whenever a router or an incidency is added or removed
+   *
+   * Used to invalidate cached views of the router graph.
+   */
+  static uint32_t
+  GetTopologyVersion();
+
+  /**
+   * @brief Add a next hop to the FIB of this router and record it in the route holder index
+   */
+  void
+  AddRoute(const Name& prefix, shared_ptr<Face> face, uint64_t cost);
+
+  /**
+   * @brief Remove all next hops of @p prefix from the FIB of this router
+   */
+  void
+  RemoveRoutes(const Name& prefix);
+
+  /**
+   * @brief Get next hops added through AddRoute and not removed since
+   */
+  const RoutedPrefixMap&
+  GetRoutedPrefixes() const;
+
+  /**
+   * @brief Get the FIB entries installed for the routes of GetRoutedPrefixes
+   *
+   * Without the AggregateRoutes attribute, these are the routes themselves.  With it, a route
+   * is left out of the FIB when its longest prefix match already yields the same next hops.
+   * With CoverSiblings as well, sibling routes sharing next hops may be covered by an entry for
+   * their parent prefix, which also forwards names under the parent that have no route.
+   */
+  const RoutedPrefixMap&
+  GetFibEntries() const;
+
+  /**
+   * @brief Aggregate FIB entries of the route groups changed since the last call
+   *
+   * Only used with the AggregateRoutes attribute.  Routes are installed in the FIB as they are
+   * added, and aggregated by this method, which is scheduled after every change.
+   */
+  void
+  AggregateRoutes();
+
+  typedef void (*AggregatedRoutesCallback)(uint32_t routes, uint32_t fibEntries);
+
+  /**
+   * @brief Get routers that hold next hops for @p prefix added through AddRoute, by ID
+   */
+  static std::vector<Ptr<GlobalRouter>>
+  GetRouteHolders(const Name& prefix);
+  /* PDRM Change */
+
   /**
    * @brief Clear global state
    */
@@ -124,6 +239,29 @@ protected:
   NotifyNewAggregate(); ///< @brief Notify when the object is aggregated to another object (e.g.,
                         /// Node)
 
+  /* PDRM Change */
+  virtual void
+  DoDispose();
+  /* PDRM Change */
+
+private:
+  /* PDRM Change */
+  void
+  InstallFibEntry(const Name& prefix, const RouteActionList& routes);
+
+  void
+  Aggregate(const Name& parent);
+
+  void
+  Disaggregate(const Name& parent);
+
+  bool
+  CanCover(const Name& parent) const;
+
+  const RouteActionList*
+  FindRoutes(const Name& prefix) const;
+  /* PDRM Change */
+
 private:
   uint32_t m_id;
 
@@ -131,7 +269,29 @@ private:
   LocalPrefixList m_localPrefixes;
   IncidencyList m_incidencies;
 
+  /* PDRM Change */
+  DistanceList m_distances;
+  std::vector<uint16_t> m_incidencyMetrics;
+  InstalledRouteMap m_installedRoutes;
+  std::unordered_map<Name, uint32_t, NameHash> m_localPrefixCounts;
+  RoutedPrefixMap m_routedPrefixes;
+
+  bool m_aggregateRoutes;
+  bool m_coverSiblings;
+  RoutedPrefixMap m_fibEntries;
+  std::unordered_map<Name, std::set<Name>, NameHash> m_routedChildren;
+  std::set<Name> m_coverEntries; ///< @brief FIB entries of parents that have no route themselves
+  std::set<Name> m_dirtyGroups;
+  EventId m_aggregationEvent;
+  TracedCallback<uint32_t, uint32_t> m_aggregatedRoutes;
+  /* PDRM Change */
+
   static uint32_t m_idCounter;
+
+  /* PDRM Change */
+  static uint32_t m_topologyVersion;
+  static std::unordered_map<Name, std::map<uint32_t, Ptr<GlobalRouter>>, NameHash> m_routeHolders;
+  /* PDRM Change */
 };
 
 inline bool
@@ -19,11 +19,8 @@
 
 #include "ndn-header.hpp"
 
-#include <iosfwd>
-#include <boost/iostreams/concepts.hpp>
-#include <boost/iostreams/stream.hpp>
-
-namespace io = boost::iostreams;
+#include <ndn-cxx/encoding/buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -84,44 +81,60 @@ template<class Pkt>
 void
 PacketHeader<Pkt>::Serialize(ns3::Buffer::Iterator start) const
 {
-  start.Write(m_packet->wireEncode().wire(), m_packet->wireEncode().size());
+  const Block& wire = m_packet->wireEncode();
+  start.Write(wire.wire(), wire.size());
 }
 
-class Ns3BufferIteratorSource : public io::source {
-public:
-  Ns3BufferIteratorSource(ns3::Buffer::Iterator& is)
-    : m_is(is)
-  {
-  }
-
-  std::streamsize
-  read(char* buf, std::streamsize nMaxRead)
-  {
-    std::streamsize i = 0;
-    for (; i < nMaxRead && !m_is.IsEnd(); ++i) {
-      buf[i] = m_is.ReadU8();
-    }
-    if (i == 0) {
-      return -1;
-    }
-    else {
-      return i;
-    }
+/**
+ * @brief Read TLV VAR-NUMBER from ns3::Buffer
+ */
+static uint64_t
+readVarNumber(ns3::Buffer::Iterator& i)
+{
+  if (i.GetRemainingSize() < 1)
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
+
+  uint8_t firstOctet = i.ReadU8();
+  size_t nOctets = firstOctet < 253 ? 0 : (firstOctet == 253 ? 2 : (firstOctet == 254 ? 4 : 8));
+  if (i.GetRemainingSize() < nOctets)
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
+
+  switch (nOctets) {
+  case 0:
+    return firstOctet;
+  case 2:
+    return i.ReadNtohU16();
+  case 4:
+    return i.ReadNtohU32();
+  default:
+    return i.ReadNtohU64();
   }
-
-private:
-  ns3::Buffer::Iterator& m_is;
-};
+}
 
 template<class Pkt>
 uint32_t
 PacketHeader<Pkt>::Deserialize(ns3::Buffer::Iterator start)
 {
+  // Determine size of the TLV block from its TYPE and LENGTH, then copy the block into a buffer
+  // that is directly shared with the decoded Block (no intermediate stream copy).
+  // Buffer::Iterator::Read still goes octet by octet; Convert::FromPacket avoids this path
+  // and copies straight from the packet with Packet::CopyData
+  ns3::Buffer::Iterator i = start;
+  readVarNumber(i); // TLV-TYPE
+  uint64_t length = readVarNumber(i);
+  uint64_t headerSize = i.GetDistanceFrom(start);
+
+  if (length > i.GetRemainingSize())
+    throw ::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV");
+
+  uint32_t size = static_cast<uint32_t>(headerSize + length);
+  auto buffer = make_shared<::ndn::Buffer>(size);
+  start.Read(buffer->buf(), size);
+
   auto packet = make_shared<Pkt>();
-  io::stream<Ns3BufferIteratorSource> is(start);
-  packet->wireDecode(::ndn::Block::fromStream(is));
+  packet->wireDecode(::ndn::Block(buffer));
   m_packet = packet;
-  return packet->wireEncode().size();
+  return size;
 }
 
 template<>
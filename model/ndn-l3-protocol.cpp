@@ -331,6 +331,60 @@ L3Protocol::getStrategyChoiceManager()
   return m_impl->m_strategyChoiceManager;
 }
 
+/* PDRM Change */
+void
+L3Protocol::addNextHop(const Name& prefix, shared_ptr<Face> face, uint64_t cost)
+{
+  NS_LOG_FUNCTION(this << prefix << face->getId() << cost);
+
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+  fib.insert(prefix).first->addNextHop(face, cost);
+}
+
+void
+L3Protocol::removeNextHop(const Name& prefix, shared_ptr<Face> face)
+{
+  NS_LOG_FUNCTION(this << prefix << face->getId());
+
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+  shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch(prefix);
+  if (entry == nullptr)
+    return;
+
+  entry->removeNextHop(face);
+  if (!entry->hasNextHops()) {
+    fib.erase(*entry);
+  }
+}
+
+void
+L3Protocol::removeNextHops(const Name& prefix)
+{
+  NS_LOG_FUNCTION(this << prefix);
+
+  nfd::Fib& fib = m_impl->m_forwarder->getFib();
+  shared_ptr<nfd::fib::Entry> entry = fib.findExactMatch(prefix);
+  if (entry != nullptr) {
+    fib.erase(*entry);
+  }
+}
+
+void
+L3Protocol::updateFib(const std::vector<FibUpdate>& updates)
+{
+  NS_LOG_FUNCTION(this << updates.size());
+
+  for (const auto& update : updates) {
+    if (std::get<2>(update) < 0) {
+      removeNextHop(std::get<0>(update), std::get<1>(update));
+    }
+    else {
+      addNextHop(std::get<0>(update), std::get<1>(update), std::get<2>(update));
+    }
+  }
+}
+/* PDRM Change */
+
 nfd::ConfigSection&
 L3Protocol::getConfig()
 {
@@ -24,6 +24,7 @@
 #include "ns3/ndnSIM/model/ndn-face.hpp"
 
 #include <list>
+#include <tuple>
 #include <vector>
 
 #include "ns3/ptr.h"
@@ -142,6 +143,45 @@ public:
   shared_ptr<Face>
   getFaceByNetDevice(Ptr<NetDevice> netDevice) const;
 
+  /* PDRM Change */
+  /**
+   * \brief FIB update: prefix, face, and cost
+   *
+   * A negative cost requests removal of the face from next hops of the prefix
+   */
+  typedef std::tuple<Name, shared_ptr<Face>, int32_t> FibUpdate;
+
+  /**
+   * \brief Add next hop to FIB entry (or update its cost), creating the entry if needed
+   *
+   * Unlike FibHelper::AddRoute, the FIB is modified directly, without creating a signed
+   * command Interest and dispatching it to nfd::FibManager.  Intended for
+   * simulation-internal callers, e.g., routing helpers.
+   */
+  void
+  addNextHop(const Name& prefix, shared_ptr<Face> face, uint64_t cost);
+
+  /**
+   * \brief Remove next hop from FIB entry, erasing the entry if no next hops remain
+   *
+   * Direct counterpart of FibHelper::RemoveRoute
+   */
+  void
+  removeNextHop(const Name& prefix, shared_ptr<Face> face);
+
+  /**
+   * \brief Remove all next hops of FIB entry
+   */
+  void
+  removeNextHops(const Name& prefix);
+
+  /**
+   * \brief Apply a batch of FIB updates in one call, in the order given
+   */
+  void
+  updateFib(const std::vector<FibUpdate>& updates);
+  /* PDRM Change */
+
   /**
    * \brief Get NFD config (boost::property_tree)
    */
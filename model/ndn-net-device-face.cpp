@@ -33,6 +33,7 @@
 #include "ns3/channel.h"
 
 #include "../utils/ndn-fw-hop-count-tag.hpp"
+#include "../utils/ndn-ns3-packet-tag.hpp"
 
 NS_LOG_COMPONENT_DEFINE("ndn.NetDeviceFace");
 
@@ -74,17 +75,33 @@ NetDeviceFace::GetNetDevice() const
   return m_netDevice;
 }
 
+/* PDRM Change */
+/**
+ * @brief Get number of links crossed by an NDN packet received or sent by this node
+ */
+template<class Pkt>
+static uint32_t
+getHopCount(const Pkt& pkt)
+{
+  auto tag = pkt.template getTag<Ns3PacketTag>();
+  return tag != nullptr ? tag->getHopCount() : 0;
+}
+/* PDRM Change */
+
 void
-NetDeviceFace::send(Ptr<Packet> packet)
+NetDeviceFace::send(Ptr<Packet> packet, uint32_t hopCount)
 {
   NS_ASSERT_MSG(packet->GetSize() <= m_netDevice->GetMtu(),
                 "Packet size " << packet->GetSize() << " exceeds device MTU "
                                << m_netDevice->GetMtu());
 
+  /* PDRM Change */
+  // the hop count is known from the NDN packet: overwrite the copied tag in place
   FwHopCountTag tag;
-  packet->RemovePacketTag(tag);
-  tag.Increment();
-  packet->AddPacketTag(tag);
+  tag.Set(hopCount + 1);
+  if (hopCount == 0 || !packet->ReplacePacketTag(tag))
+    packet->AddPacketTag(tag);
+  /* PDRM Change */
 
   m_netDevice->Send(packet, m_netDevice->GetBroadcast(), L3Protocol::ETHERNET_FRAME_TYPE);
 }
@@ -98,8 +115,9 @@ NetDeviceFace::sendInterest(const Interest& interest)
 
   this->emitSignal(onSendInterest, interest);
 
+  uint32_t hopCount = getHopCount(interest);
   Ptr<Packet> packet = Convert::ToPacket(interest);
-  send(packet);
+  send(packet, hopCount);
 }
 
 void
@@ -109,8 +127,9 @@ NetDeviceFace::sendData(const Data& data)
 
   this->emitSignal(onSendData, data);
 
+  uint32_t hopCount = getHopCount(data);
   Ptr<Packet> packet = Convert::ToPacket(data);
-  send(packet);
+  send(packet, hopCount);
 }
 
 // callback
@@ -121,15 +140,14 @@ NetDeviceFace::receiveFromNetDevice(Ptr<NetDevice> device, Ptr<const Packet> p,
 {
   NS_LOG_FUNCTION(device << p << protocol << from << to << packetType);
 
-  Ptr<Packet> packet = p->Copy();
   try {
     uint32_t type = Convert::getPacketType(p);
     if (type == ::ndn::tlv::Interest) {
-      shared_ptr<const Interest> i = Convert::FromPacket<Interest>(packet);
+      shared_ptr<const Interest> i = Convert::FromPacket<Interest>(p);
       this->emitSignal(onReceiveInterest, *i);
     }
     else if (type == ::ndn::tlv::Data) {
-      shared_ptr<const Data> d = Convert::FromPacket<Data>(packet);
+      shared_ptr<const Data> d = Convert::FromPacket<Data>(p);
       this->emitSignal(onReceiveData, *d);
     }
     else {
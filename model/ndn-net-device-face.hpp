@@ -75,8 +75,13 @@ public:
   GetNetDevice() const;
 
 private:
+  /* PDRM Change */
+  /**
+   * @param hopCount number of links the NDN packet crossed before this one
+   */
   void
-  send(Ptr<Packet> packet);
+  send(Ptr<Packet> packet, uint32_t hopCount);
+  /* PDRM Change */
 
   /// \brief callback from lower layers
   void
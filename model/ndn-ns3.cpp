@@ -20,6 +20,8 @@
 #include "ndn-ns3.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
+#include <ndn-cxx/encoding/buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/interest.hpp>
 #include <ndn-cxx/data.hpp>
 
@@ -31,43 +33,87 @@
 namespace ns3 {
 namespace ndn {
 
+/* PDRM Change */
+/**
+ * @brief Get size of the TLV block at the start of the packet from its TLV-TYPE and TLV-LENGTH
+ */
+static uint32_t
+getTlvBlockSize(Ptr<const Packet> packet)
+{
+  // TLV-TYPE and TLV-LENGTH are at most 9 octets each
+  uint8_t header[18];
+  uint32_t nRead = packet->CopyData(header, sizeof(header));
+
+  const uint8_t* begin = header;
+  const uint8_t* end = header + nRead;
+  uint64_t type = 0;
+  uint64_t length = 0;
+  if (!::ndn::tlv::readVarNumber(begin, end, type)
+      || !::ndn::tlv::readVarNumber(begin, end, length))
+    throw ::ndn::tlv::Error("Insufficient data during TLV processing");
+
+  uint64_t size = static_cast<uint64_t>(begin - header) + length;
+  if (size > packet->GetSize())
+    throw ::ndn::tlv::Error("Not enough data in the buffer to fully parse TLV");
+
+  return static_cast<uint32_t>(size);
+}
+/* PDRM Change */
+
 template<class T>
 std::shared_ptr<const T>
-Convert::FromPacket(Ptr<Packet> packet)
+Convert::FromPacket(Ptr<const Packet> packet)
 {
-  PacketHeader<T> header;
-  packet->RemoveHeader(header);
-
-  auto pkt = header.getPacket();
-  pkt->setTag(make_shared<Ns3PacketTag>(packet));
+  /* PDRM Change */
+  // the TLV block is copied from the packet buffer at once into the buffer that backs the
+  // decoded Block, and the received packet is shared as is (no copy), including its header
+  uint32_t size = getTlvBlockSize(packet);
+  auto buffer = make_shared<::ndn::Buffer>(size);
+  packet->CopyData(buffer->buf(), size);
+
+  auto pkt = make_shared<T>();
+  pkt->wireDecode(::ndn::Block(buffer));
+  /* PDRM Change */
+  pkt->setTag(make_shared<Ns3PacketTag>(packet, pkt->wireEncode()));
 
   return pkt;
 }
 
 template std::shared_ptr<const Interest>
-Convert::FromPacket<Interest>(Ptr<Packet> packet);
+Convert::FromPacket<Interest>(Ptr<const Packet> packet);
 
 template std::shared_ptr<const Data>
-Convert::FromPacket<Data>(Ptr<Packet> packet);
+Convert::FromPacket<Data>(Ptr<const Packet> packet);
 
 template<class T>
 Ptr<Packet>
 Convert::ToPacket(const T& pkt)
 {
+  auto tag = pkt.template getTag<Ns3PacketTag>();
+
+  // Unmodified packet (e.g., forwarded or sent to several faces): share the already serialized
+  // payload, only packet tags are copied
+  if (tag != nullptr && tag->isHeaderOf(pkt.wireEncode())) {
+    return tag->getPacket()->Copy();
+  }
+
   PacketHeader<T> header(pkt);
 
   Ptr<Packet> packet;
-
-  auto tag = pkt.template getTag<Ns3PacketTag>();
   if (tag != nullptr) {
     packet = tag->getPacket()->Copy();
+    packet->RemoveAtStart(tag->getHeaderSize());
   }
   else {
     packet = Create<Packet>();
   }
 
   packet->AddHeader(header);
-  return packet;
+
+  // cache serialized packet for subsequent conversions; the caller gets its own copy, as
+  // faces modify packet tags before sending
+  pkt.setTag(make_shared<Ns3PacketTag>(packet, pkt.wireEncode()));
+  return packet->Copy();
 }
 
 template Ptr<Packet>
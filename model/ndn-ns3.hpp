@@ -31,7 +31,7 @@ class Convert {
 public:
   template<class T>
   static std::shared_ptr<const T>
-  FromPacket(Ptr<Packet> packet);
+  FromPacket(Ptr<const Packet> packet);
 
   template<class T>
   static Ptr<Packet>
@@ -110,7 +110,8 @@ Tester::printStats(std::ostream& os, Time nextPrintTime, double beginRealTime)
     if (pitSize != 0)
       pitCount += pitSize;
 
-    if (true != true) {
+    /* PDRM Change */
+    if (!m_oldContentStore.empty()) {
       Ptr<ndn::ContentStore> cs = (*node)->GetObject<ndn::ContentStore>();
       if (cs != 0)
         csCount += cs->GetSize();
@@ -120,6 +121,7 @@ Tester::printStats(std::ostream& os, Time nextPrintTime, double beginRealTime)
       if (csSize != 0)
         csCount += csSize;
     }
+    /* PDRM Change */
   }
 
   os << "pit:" << pitCount << "\t";
@@ -132,7 +134,7 @@ Tester::printStats(std::ostream& os, Time nextPrintTime, double beginRealTime)
     if (m_shouldEvaluatePit) {
       if (pitCount != 0) {
         os << "Approximate memory overhead per PIT entry:"
-           <<  1000 * (finalOverhead - m_initialOverhead) / pitCount << "KiB\n";
+           <<  1024 * (finalOverhead - m_initialOverhead) / pitCount << "KiB\n";
       }
       else {
         os << "`The number of PIT entries is equal to zero\n";
@@ -141,7 +143,7 @@ Tester::printStats(std::ostream& os, Time nextPrintTime, double beginRealTime)
     else {
       if (csCount != 0) {
         os << "Approximate memory overhead per CS entry:"
-           <<  1000 * (finalOverhead - m_initialOverhead) / csCount << "KiB\n";
+           <<  1024 * (finalOverhead - m_initialOverhead) / csCount << "KiB\n";
       }
       else {
         os << "The number of CS entries is equal to zero\n";
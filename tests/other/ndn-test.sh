@@ -33,6 +33,21 @@ size=100000
 rate=100
 sim_time=$(( 2000 / rate ))
 
+# scenarios using the ndnSIM CS
+echo "Using ndnSIM's CS.."
+
+# scenarios for the evaluation of memory overhead per CS entry
+echo "Evaluation of memory overhead per CS entry.."
+
+echo "CS size = " $size, "interest rate = " $rate
+
+# using best route forwarding strategy
+echo "Using best route forwarding strategy.."
+
+../../../waf --run ndn-test --command-template="%s --old-cs=ns3::ndn::cs::Lru --cs-size=${size} --rate=${rate} --strategy="/localhost/nfd/strategy/best-route" --sim-time=${sim_time}"
+
+echo
+
 # scenarios using the NFD's CS
 echo "Using NFD's CS.."
 
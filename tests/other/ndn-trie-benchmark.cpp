@@ -0,0 +1,155 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+// ndn-trie-benchmark.cpp
+
+#include "ns3/core-module.h"
+
+#include "ns3/ndnSIM/model/cs/ndn-content-store.hpp"
+#include "ns3/ndnSIM/utils/trie/trie-with-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/lru-policy.hpp"
+#include "ns3/ndnSIM/utils/trie/radix-trie.hpp"
+
+#include <chrono>
+#include <memory>
+
+namespace ns3 {
+
+/**
+ * Microbenchmark of the trie behind the ndnSIM content stores, on names of PDRM chunks
+ * (/producer<P>/catalog/obj<O>/v<V>/<chunk>, 5 components)
+ *
+ * Compares cache lookup throughput when the component hashes are computed by every lookup and
+ * when they are computed once per name and passed along, and the same lookups on the
+ * path-compressed trie:
+ *
+ *     ./waf --run "ndn-trie-benchmark --objects=1000 --chunks=20 --rounds=20"
+ */
+class TrieBenchmark {
+public:
+  typedef ndn::ndnSIM::trie_with_policy<ndn::Name, ndn::ndnSIM::pointer_payload_traits<int>,
+                                        ndn::ndnSIM::lru_policy_traits> Trie;
+  typedef ndn::ndnSIM::
+    trie_with_policy<ndn::Name, ndn::ndnSIM::pointer_payload_traits<int>,
+                     ndn::ndnSIM::radix_policy_traits<ndn::ndnSIM::lru_policy_traits>> RadixTrie;
+
+  TrieBenchmark()
+    : m_objects(1000)
+    , m_chunks(20)
+    , m_rounds(20)
+  {
+  }
+
+  int
+  run(int argc, char* argv[]);
+
+private:
+  template<class Lookup>
+  void
+  measure(const std::string& label, Lookup lookup);
+
+private:
+  uint32_t m_objects;
+  uint32_t m_chunks;
+  uint32_t m_rounds;
+
+  std::vector<ndn::Name> m_names;
+};
+
+template<class Lookup>
+void
+TrieBenchmark::measure(const std::string& label, Lookup lookup)
+{
+  size_t hits = 0;
+  auto begin = std::chrono::steady_clock::now();
+  for (uint32_t round = 0; round < m_rounds; round++) {
+    for (size_t i = 0; i < m_names.size(); i++) {
+      hits += lookup(i) ? 1 : 0;
+    }
+  }
+  std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - begin;
+
+  double lookups = static_cast<double>(m_rounds) * m_names.size();
+  std::cout << label << "\t" << lookups << "\t" << elapsed.count() << "\t"
+            << lookups / elapsed.count() << "\t" << hits << "\n";
+}
+
+int
+TrieBenchmark::run(int argc, char* argv[])
+{
+  CommandLine cmd;
+  cmd.AddValue("objects", "Number of objects", m_objects);
+  cmd.AddValue("chunks", "Number of chunks per object", m_chunks);
+  cmd.AddValue("rounds", "Number of lookups of each chunk", m_rounds);
+  cmd.Parse(argc, argv);
+
+  int payload = 0;
+  Trie trie;
+  trie.getPolicy().set_max_size(0);
+  RadixTrie radixTrie;
+  radixTrie.getPolicy().set_max_size(0);
+
+  for (uint32_t object = 0; object < m_objects; object++) {
+    ndn::Name name("/producer" + std::to_string(object % 16));
+    name.append("catalog").append("obj" + std::to_string(object)).append("v1");
+    for (uint32_t chunk = 0; chunk < m_chunks; chunk++) {
+      m_names.push_back(ndn::Name(name).appendSequenceNumber(chunk));
+      trie.insert(m_names.back(), &payload);
+      radixTrie.insert(m_names.back(), &payload);
+    }
+  }
+
+  std::vector<std::unique_ptr<Trie::key_hashes_type>> hashes;
+  for (const auto& name : m_names) {
+    hashes.emplace_back(new Trie::key_hashes_type(name));
+  }
+
+  std::cout << "Lookup\tLookups\tSeconds\tLookupsPerSecond\tHits\n";
+
+  measure("HashPerLookup", [&] (size_t i) {
+      return trie.deepest_prefix_match(m_names[i]) != trie.end();
+    });
+
+  measure("PrecomputedHashes", [&] (size_t i) {
+      return trie.deepest_prefix_match(m_names[i], *hashes[i]) != trie.end();
+    });
+
+  measure("RadixHashPerLookup", [&] (size_t i) {
+      return radixTrie.deepest_prefix_match(m_names[i]) != radixTrie.end();
+    });
+
+  measure("RadixPrecomputedHashes", [&] (size_t i) {
+      return radixTrie.deepest_prefix_match(m_names[i], *hashes[i]) != radixTrie.end();
+    });
+
+  measure("HashOnly", [&] (size_t i) {
+      return Trie::key_hashes_type(m_names[i])[0] != 0;
+    });
+
+  return 0;
+}
+
+} // namespace ns3
+
+int
+main(int argc, char* argv[])
+{
+  ns3::TrieBenchmark benchmark;
+  return benchmark.run(argc, argv);
+}
@@ -18,6 +18,8 @@
  **/
 
 #include "helper/ndn-fib-helper.hpp"
+#include "model/ndn-l3-protocol.hpp"
+#include "fw/forwarder.hpp"
 
 #include "../tests-common.hpp"
 
@@ -97,6 +99,27 @@ BOOST_AUTO_TEST_CASE(Helper4)
   FibHelper::AddRoute(getNode("1"), Name("/prefix"), getNode("2"), 10);
 }
 
+// void
+// L3Protocol::addNextHop(const Name& prefix, shared_ptr<Face> face, uint64_t cost);
+BOOST_AUTO_TEST_CASE(Direct)
+{
+  getNode("1")->GetObject<L3Protocol>()->addNextHop("/prefix", getFace("1", "2"), 1);
+}
+
+// void
+// L3Protocol::updateFib(const std::vector<FibUpdate>& updates);
+BOOST_AUTO_TEST_CASE(DirectBatch)
+{
+  getNode("1")->GetObject<L3Protocol>()->updateFib({
+      L3Protocol::FibUpdate("/other", getFace("1", "2"), 1),
+      L3Protocol::FibUpdate("/prefix", getFace("1", "2"), 10),
+      L3Protocol::FibUpdate("/other", getFace("1", "2"), -1),
+    });
+
+  BOOST_CHECK(getNode("1")->GetObject<L3Protocol>()->getForwarder()
+                ->getFib().findExactMatch("/other") == nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END() // AddRoute
 
 BOOST_AUTO_TEST_SUITE_END() // HelperNdnFibHelper
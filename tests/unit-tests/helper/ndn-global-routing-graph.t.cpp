@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-global-routing-graph.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+#include "helper/boost-graph-ndn-global-routing-helper.hpp"
+
+#include "model/ndn-global-router.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../tests-common.hpp"
+
+#include <boost/graph/dijkstra_shortest_paths.hpp>
+#include <boost/filesystem.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+const boost::filesystem::path TEST_GRAPH_TOPO_TXT =
+  boost::filesystem::path(TEST_CONFIG_PATH) / "graph-topo.txt";
+
+class GlobalRoutingGraphFixture : public CleanupFixture
+{
+public:
+  GlobalRoutingGraphFixture()
+  {
+    boost::filesystem::create_directories(TEST_CONFIG_PATH);
+
+    ofstream file(TEST_GRAPH_TOPO_TXT.string().c_str());
+    file << "router\n\n"
+         << "#node city  y x mpi-partition\n"
+         << "A5  NA  1 1 1\n"
+         << "B5  NA  80  -40 1\n"
+         << "C5  NA  80  40  1\n"
+         << "D5  NA  1  80  1\n"
+         << "E5  NA  40  120  1\n\n"
+         << "link\n\n"
+         << "# from  to  capacity  metric  delay queue\n"
+         << "A5      B5  10Mbps    100 1ms 100\n"
+         << "A5      C5  10Mbps    50  1ms 100\n"
+         << "B5      C5  10Mbps    1 1ms 100\n"
+         << "C5      D5  10Mbps    5 1ms 100\n";
+    file.close();
+
+    AnnotatedTopologyReader topologyReader("");
+    topologyReader.SetFileName(TEST_GRAPH_TOPO_TXT.string().c_str());
+    topologyReader.Read();
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    topologyReader.ApplyOspfMetric();
+
+    GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+  }
+
+  ~GlobalRoutingGraphFixture()
+  {
+    boost::filesystem::remove(TEST_GRAPH_TOPO_TXT);
+  }
+
+  Ptr<GlobalRouter>
+  getRouter(const std::string& node)
+  {
+    return Names::Find<Node>(node)->GetObject<GlobalRouter>();
+  }
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperGlobalRoutingGraph, GlobalRoutingGraphFixture)
+
+BOOST_AUTO_TEST_CASE(ShortestPathsFrom)
+{
+  GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+  boost::NdnGlobalRouterGraph reference;
+
+  for (const auto& source : reference.GetVertices()) {
+    GlobalRouter::DistanceList distances;
+    graph.ShortestPathsFrom(source->GetId(), distances);
+
+    boost::DistancesMap expected;
+    dijkstra_shortest_paths(reference, source,
+                            distance_map(boost::ref(expected))
+                              .distance_inf(boost::WeightInf)
+                              .distance_zero(boost::WeightZero)
+                              .distance_compare(boost::WeightCompare())
+                              .distance_combine(boost::WeightCombine()));
+
+    BOOST_REQUIRE_EQUAL(distances.size(), graph.GetSize());
+    for (const auto& dist : expected) {
+      const GlobalRouter::Distance& distance = distances[dist.first->GetId()];
+      BOOST_CHECK_EQUAL(std::get<1>(distance), std::get<1>(dist.second));
+      BOOST_CHECK(std::get<0>(distance) == std::get<0>(dist.second));
+    }
+  }
+
+  // E5 has no links
+  GlobalRouter::DistanceList distances;
+  graph.ShortestPathsFrom(getRouter("A5")->GetId(), distances);
+  BOOST_CHECK_EQUAL(std::get<1>(distances[getRouter("E5")->GetId()]),
+                    GlobalRoutingGraph::INFINITE_COST);
+  BOOST_CHECK(std::get<0>(distances[getRouter("E5")->GetId()]) == nullptr);
+}
+
+BOOST_AUTO_TEST_CASE(ShortestPathsTo)
+{
+  GlobalRoutingGraph& graph = GlobalRoutingGraph::Get();
+
+  GlobalRouter::DistanceList toD;
+  std::vector<uint32_t> successors;
+  graph.ShortestPathsTo(getRouter("D5")->GetId(), toD, &successors);
+
+  for (const std::string& node : {"A5", "B5", "C5"}) {
+    GlobalRouter::DistanceList fromNode;
+    graph.ShortestPathsFrom(getRouter(node)->GetId(), fromNode);
+
+    const GlobalRouter::Distance& expected = fromNode[getRouter("D5")->GetId()];
+    const GlobalRouter::Distance& actual = toD[getRouter(node)->GetId()];
+    BOOST_CHECK_EQUAL(std::get<1>(actual), std::get<1>(expected));
+    BOOST_CHECK(std::get<0>(actual) == std::get<0>(expected));
+    BOOST_CHECK_CLOSE(std::get<2>(actual), std::get<2>(expected), 1e-6);
+  }
+
+  BOOST_CHECK_EQUAL(std::get<1>(toD[getRouter("A5")->GetId()]), 55);
+  // A5 -> C5 -> D5 over two 1ms links
+  BOOST_CHECK_CLOSE(std::get<2>(toD[getRouter("A5")->GetId()]), 0.002, 1e-6);
+  BOOST_CHECK_EQUAL(std::get<2>(toD[getRouter("D5")->GetId()]), 0.0);
+  BOOST_CHECK_EQUAL(std::get<1>(toD[getRouter("D5")->GetId()]), 0);
+  BOOST_CHECK_EQUAL(successors[getRouter("D5")->GetId()], GlobalRoutingGraph::NO_VERTEX);
+  BOOST_CHECK(successors[getRouter("A5")->GetId()] != GlobalRoutingGraph::NO_VERTEX);
+}
+
+BOOST_AUTO_TEST_CASE(MetricChange)
+{
+  GlobalRouter::DistanceList distances;
+  GlobalRoutingGraph::Get().ShortestPathsFrom(getRouter("A5")->GetId(), distances);
+  BOOST_CHECK_EQUAL(std::get<1>(distances[getRouter("D5")->GetId()]), 55);
+
+  // metrics are re-read on every Get, without a rebuild
+  for (const auto& incidency : getRouter("A5")->GetIncidencies()) {
+    std::get<1>(incidency)->setMetric(1);
+  }
+
+  GlobalRoutingGraph::Get().ShortestPathsFrom(getRouter("A5")->GetId(), distances);
+  BOOST_CHECK_EQUAL(std::get<1>(distances[getRouter("D5")->GetId()]), 6);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
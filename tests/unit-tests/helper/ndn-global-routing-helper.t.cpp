@@ -18,6 +18,8 @@
  **/
 
 #include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
+#include "helper/ndn-fib-helper.hpp"
 
 #include "model/ndn-global-router.hpp"
 #include "model/ndn-l3-protocol.hpp"
@@ -146,6 +148,687 @@ BOOST_AUTO_TEST_CASE(CalculateRouteCase2)
   }
 }
 
+BOOST_AUTO_TEST_CASE(CalculateRoutesIncremental)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A3  NA  1 1 1\n"
+        << "B3  NA  80  -40 1\n"
+        << "C3  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A3      B3  10Mbps    100 1ms 100\n"
+        << "A3      C3  10Mbps    50  1ms 100\n"
+        << "B3      C3  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  ndnGlobalRoutingHelper.AddOrigins("/prod", Names::Find<Node>("C3"));
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutesIncremental(), 0);
+
+  auto getNextHops = [] (const std::string& node) {
+    std::map<std::string, uint64_t> nextHops;
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    for (auto& nextHop : ndn->getForwarder()->getFib().findExactMatch("/prod")->getNextHops()) {
+      auto face = dynamic_pointer_cast<ndn::NetDeviceFace>(nextHop.getFace());
+      Ptr<Channel> channel = face->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0)->GetNode();
+      if (Names::FindName(other) == node)
+        other = channel->GetDevice(1)->GetNode();
+      nextHops[Names::FindName(other)] = nextHop.getCost();
+    }
+    return nextHops;
+  };
+
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A3")["C3"], 50);
+
+  // nothing changed, nothing recomputed
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutesIncremental(), 0);
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 1);
+
+  // A3 now reaches C3 through B3, the stale next hop is counted as a change
+  ndn::LinkControlHelper::FailLink(Names::Find<Node>("A3"), Names::Find<Node>("C3"));
+  BOOST_CHECK_EQUAL(ndn::GlobalRoutingHelper::CalculateRoutesIncremental(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A3").size(), 2);
+  BOOST_CHECK_EQUAL(getNextHops("A3")["B3"], 101);
+  BOOST_CHECK_EQUAL(getNextHops("B3")["C3"], 1);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesForPrefix)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A4  NA  1 1 1\n"
+        << "B4  NA  80  -40 1\n"
+        << "C4  NA  80  40  1\n"
+        << "D4  NA  1  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A4      B4  10Mbps    100 1ms 100\n"
+        << "A4      C4  10Mbps    50  1ms 100\n"
+        << "B4      C4  10Mbps    1 1ms 100\n"
+        << "C4      D4  10Mbps    5 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  auto getNextHops = [] (const std::string& node, const std::string& prefix) {
+    std::map<std::string, uint64_t> nextHops;
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    auto entry = ndn->getForwarder()->getFib().findExactMatch(prefix);
+    if (entry == nullptr)
+      return nextHops;
+    for (auto& nextHop : entry->getNextHops()) {
+      auto face = dynamic_pointer_cast<ndn::NetDeviceFace>(nextHop.getFace());
+      if (face == nullptr)
+        continue;
+      Ptr<Channel> channel = face->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0)->GetNode();
+      if (Names::FindName(other) == node)
+        other = channel->GetDevice(1)->GetNode();
+      nextHops[Names::FindName(other)] = nextHop.getCost();
+    }
+    return nextHops;
+  };
+
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("D4"));
+  ndnGlobalRoutingHelper.AddOrigins("/other", Names::Find<Node>("B4"));
+  ndn::GlobalRoutingHelper::CalculateRoutes("/prefix");
+
+  BOOST_CHECK_EQUAL(getNextHops("A4", "/prefix").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A4", "/prefix")["C4"], 55);
+  BOOST_CHECK_EQUAL(getNextHops("B4", "/prefix")["C4"], 6);
+  BOOST_CHECK_EQUAL(getNextHops("C4", "/prefix")["D4"], 5);
+
+  // routes to other prefixes are left alone
+  BOOST_CHECK(getNextHops("A4", "/other").empty());
+
+  // second origin, next hops accumulate as with the full computation
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("B4"));
+  ndn::GlobalRoutingHelper::CalculateRoutes("/prefix");
+
+  std::map<std::string, std::map<std::string, uint64_t>> perPrefix;
+  for (const std::string& node : {"A4", "B4", "C4", "D4"}) {
+    perPrefix[node] = getNextHops(node, "/prefix");
+  }
+  BOOST_CHECK_EQUAL(perPrefix["C4"].size(), 2);
+  BOOST_CHECK_EQUAL(perPrefix["C4"]["B4"], 1);
+  BOOST_CHECK_EQUAL(perPrefix["C4"]["D4"], 5);
+  BOOST_CHECK(perPrefix["B4"].empty()); // B4 is an origin itself
+
+  // same next hop faces as the full computation (costs of a face shared by both origins depend
+  // on the order in which the full computation visits them)
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  for (const std::string& node : {"A4", "B4", "C4", "D4"}) {
+    auto full = getNextHops(node, "/prefix");
+    BOOST_CHECK_EQUAL(perPrefix[node].size(), full.size());
+    for (const auto& nextHop : perPrefix[node]) {
+      BOOST_CHECK_EQUAL(full.count(nextHop.first), 1);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesForNestedPrefixes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A10  NA  1 1 1\n"
+        << "B10  NA  80  -40 1\n"
+        << "C10  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A10      B10  10Mbps    1 1ms 100\n"
+        << "B10      C10  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  auto dumpFibs = [] {
+    std::set<std::string> fibs;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto ndn = (*node)->GetObject<ndn::L3Protocol>();
+      for (const auto& entry : ndn->getForwarder()->getFib()) {
+        for (auto& nextHop : entry.getNextHops()) {
+          fibs.insert(Names::FindName(*node) + " " + entry.getPrefix().toUri() + " "
+                      + std::to_string(nextHop.getFace()->getId()) + " "
+                      + std::to_string(nextHop.getCost()));
+        }
+      }
+    }
+    return fibs;
+  };
+  auto hasRoute = [] (const std::string& node, const std::string& prefix) {
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    return ndn->getForwarder()->getFib().findExactMatch(prefix) != nullptr;
+  };
+
+  ndnGlobalRoutingHelper.AddOrigin("/prod3/objX", "C10");
+  ndnGlobalRoutingHelper.AddOrigin("/prod3/objY", "C10");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(hasRoute("A10", "/prod3/objX"));
+
+  // A10 starts originating the covering prefix: it no longer routes towards the objects
+  ndnGlobalRoutingHelper.AddOrigin("/prod3", "A10");
+  ndn::GlobalRoutingHelper::CalculateRoutes("/prod3");
+  std::set<std::string> perPrefix = dumpFibs();
+  BOOST_CHECK(!hasRoute("A10", "/prod3/objX"));
+  BOOST_CHECK(!hasRoute("A10", "/prod3/objY"));
+  BOOST_CHECK(hasRoute("B10", "/prod3"));
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(dumpFibs() == perPrefix);
+
+  // and gets its routes to the objects back when it stops
+  ndnGlobalRoutingHelper.RemoveOrigin("/prod3", Names::Find<Node>("A10"));
+  ndn::GlobalRoutingHelper::CalculateRoutes("/prod3");
+  perPrefix = dumpFibs();
+  BOOST_CHECK(hasRoute("A10", "/prod3/objX"));
+  BOOST_CHECK(hasRoute("A10", "/prod3/objY"));
+
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(dumpFibs() == perPrefix);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A7  NA  1 1 1\n"
+        << "B7  NA  80  -40 1\n"
+        << "C7  NA  80  40  1\n"
+        << "D7  NA  1  80  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A7      B7  10Mbps    100 1ms 100\n"
+        << "A7      C7  10Mbps    50  1ms 100\n"
+        << "B7      C7  10Mbps    1 1ms 100\n"
+        << "C7      D7  10Mbps    5 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("D7"));
+
+  std::vector<uint16_t> metrics;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (const auto& face : (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFaceTable()) {
+      metrics.push_back(face->getMetric());
+    }
+  }
+
+  auto getNextHops = [] (const std::string& node) {
+    std::map<std::string, uint64_t> nextHops;
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    auto entry = ndn->getForwarder()->getFib().findExactMatch("/prefix");
+    if (entry == nullptr)
+      return nextHops;
+    for (auto& nextHop : entry->getNextHops()) {
+      auto face = dynamic_pointer_cast<ndn::NetDeviceFace>(nextHop.getFace());
+      if (face == nullptr)
+        continue;
+      Ptr<Channel> channel = face->GetNetDevice()->GetChannel();
+      Ptr<Node> other = channel->GetDevice(0)->GetNode();
+      if (Names::FindName(other) == node)
+        other = channel->GetDevice(1)->GetNode();
+      nextHops[Names::FindName(other)] = nextHop.getCost();
+    }
+    return nextHops;
+  };
+
+  auto clearFibs = [] {
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      ndn::FibHelper::RemoveRoutes(*node, "/prefix");
+    }
+  };
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  BOOST_CHECK_EQUAL(getNextHops("A7").size(), 2);
+  BOOST_CHECK_EQUAL(getNextHops("A7")["C7"], 55);
+  BOOST_CHECK_EQUAL(getNextHops("A7")["B7"], 106);
+  BOOST_CHECK_EQUAL(getNextHops("B7")["C7"], 6);
+  BOOST_CHECK_EQUAL(getNextHops("B7")["A7"], 155);
+  // A7 and B7 reach D7 through C7, so C7 must not send Interests back to them
+  BOOST_CHECK_EQUAL(getNextHops("C7").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("C7")["D7"], 5);
+
+  // face metrics are left untouched
+  size_t i = 0;
+  for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+    for (const auto& face : (*node)->GetObject<ndn::L3Protocol>()->getForwarder()->getFaceTable()) {
+      BOOST_CHECK_EQUAL(face->getMetric(), metrics[i++]);
+    }
+  }
+
+  // A7 is farther from D7 than B7, so it is not a downstream neighbor of B7
+  clearFibs();
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes(0, true);
+  BOOST_CHECK_EQUAL(getNextHops("C7").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("C7")["D7"], 5);
+  BOOST_CHECK_EQUAL(getNextHops("B7").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("B7")["C7"], 6);
+  BOOST_CHECK_EQUAL(getNextHops("A7").size(), 2);
+
+  clearFibs();
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes(1);
+  BOOST_CHECK_EQUAL(getNextHops("A7").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("A7")["C7"], 55);
+  BOOST_CHECK_EQUAL(getNextHops("C7").size(), 1);
+  BOOST_CHECK_EQUAL(getNextHops("C7")["D7"], 5);
+}
+
+BOOST_AUTO_TEST_CASE(CalculateAllPossibleRoutesChain)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A12  NA  1 1 1\n"
+        << "B12  NA  80  -40 1\n"
+        << "C12  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A12     B12 10Mbps    1 1ms 100\n"
+        << "B12     C12 10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigins("/prefix", Names::Find<Node>("C12"));
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+
+  auto getEntry = [] (const std::string& node) {
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    return ndn->getForwarder()->getFib().findExactMatch("/prefix");
+  };
+
+  // B12 would otherwise forward to A12, whose only way to C12 is back through B12
+  BOOST_REQUIRE(getEntry("B12") != nullptr);
+  BOOST_REQUIRE_EQUAL(getEntry("B12")->getNextHops().size(), 1);
+  BOOST_CHECK_EQUAL(getEntry("B12")->getNextHops().front().getCost(), 1);
+  BOOST_REQUIRE(getEntry("A12") != nullptr);
+  BOOST_CHECK_EQUAL(getEntry("A12")->getNextHops().size(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(RemoveOrigin)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A8  NA  1 1 1\n"
+        << "B8  NA  80  -40 1\n"
+        << "C8  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A8      B8  10Mbps    1 1ms 100\n"
+        << "B8      C8  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOrigin("/a", "C8");
+  ndnGlobalRoutingHelper.AddOrigin("/b", "C8");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+
+  auto getRouter = [] (const std::string& node) {
+    return Names::Find<Node>(node)->GetObject<ndn::GlobalRouter>();
+  };
+  auto hasRoute = [] (const std::string& node, const std::string& prefix) {
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    return ndn->getForwarder()->getFib().findExactMatch(prefix) != nullptr;
+  };
+
+  BOOST_CHECK(getRouter("C8")->HasLocalPrefix("/a"));
+  BOOST_CHECK(!getRouter("B8")->HasLocalPrefix("/a"));
+
+  std::vector<Ptr<ndn::GlobalRouter>> holders = ndn::GlobalRouter::GetRouteHolders("/a");
+  BOOST_REQUIRE_EQUAL(holders.size(), 2);
+  BOOST_CHECK(holders[0] == getRouter("A8") || holders[1] == getRouter("A8"));
+  BOOST_CHECK(holders[0] == getRouter("B8") || holders[1] == getRouter("B8"));
+  BOOST_CHECK_EQUAL(getRouter("B8")->GetRoutedPrefixes().at("/a").size(), 1);
+
+  ndnGlobalRoutingHelper.RemoveOrigin("/a", Names::Find<Node>("C8"));
+
+  BOOST_CHECK(!getRouter("C8")->HasLocalPrefix("/a"));
+  BOOST_CHECK(getRouter("C8")->HasLocalPrefix("/b"));
+  BOOST_CHECK(ndn::GlobalRouter::GetRouteHolders("/a").empty());
+  BOOST_CHECK_EQUAL(ndn::GlobalRouter::GetRouteHolders("/b").size(), 2);
+  BOOST_CHECK(!hasRoute("A8", "/a"));
+  BOOST_CHECK(!hasRoute("B8", "/a"));
+  BOOST_CHECK(hasRoute("A8", "/b"));
+  BOOST_CHECK(hasRoute("B8", "/b"));
+
+  // routes can still be removed after the holder index is reset
+  ndn::GlobalRouter::clear();
+  FibHelper::RemoveRoutes(Names::Find<Node>("A8"), "/b");
+  BOOST_CHECK(!hasRoute("A8", "/b"));
+  BOOST_CHECK(ndn::GlobalRouter::GetRouteHolders("/b").empty());
+}
+
+BOOST_AUTO_TEST_CASE(AggregateRoutes)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A9  NA  1 1 1\n"
+        << "B9  NA  80  -40 1\n"
+        << "C9  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A9      B9  10Mbps    1 1ms 100\n"
+        << "B9      C9  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  auto getRouter = [] (const std::string& node) {
+    return Names::Find<Node>(node)->GetObject<ndn::GlobalRouter>();
+  };
+  auto getMatch = [] (const std::string& node, const std::string& name) {
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    return ndn->getForwarder()->getFib().findLongestPrefixMatch(name)->getPrefix();
+  };
+  auto aggregate = [&getRouter] {
+    for (const std::string& node : {"A9", "B9", "C9"}) {
+      getRouter(node)->AggregateRoutes();
+    }
+  };
+
+  for (const std::string& node : {"A9", "B9", "C9"}) {
+    getRouter(node)->SetAttribute("AggregateRoutes", BooleanValue(true));
+    getRouter(node)->SetAttribute("CoverSiblings", BooleanValue(true));
+  }
+
+  ndnGlobalRoutingHelper.AddOrigin("/p/o1", "C9");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o2", "C9");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o3", "C9");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o4", "A9");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  aggregate();
+
+  // B9 covers /p/o1-3 by /p, with /p/o4 as an exception
+  BOOST_CHECK_EQUAL(getRouter("B9")->GetRoutedPrefixes().size(), 4);
+  BOOST_CHECK_EQUAL(getRouter("B9")->GetFibEntries().size(), 2);
+  BOOST_CHECK_EQUAL(getRouter("A9")->GetRoutedPrefixes().size(), 3);
+  BOOST_CHECK_EQUAL(getRouter("A9")->GetFibEntries().size(), 1);
+  BOOST_CHECK_EQUAL(getMatch("B9", "/p/o1/seg=0"), Name("/p"));
+  BOOST_CHECK_EQUAL(getMatch("B9", "/p/o4/seg=0"), Name("/p/o4"));
+  // the cover also forwards siblings that have no route
+  BOOST_CHECK_EQUAL(getMatch("B9", "/p/o9/seg=0"), Name("/p"));
+
+  ndnGlobalRoutingHelper.RemoveOrigin("/p/o2", Names::Find<Node>("C9"));
+  aggregate();
+  BOOST_CHECK_EQUAL(getRouter("B9")->GetFibEntries().size(), 2);
+  BOOST_CHECK_EQUAL(getMatch("B9", "/p/o3"), Name("/p"));
+
+  // without a shared majority, every route gets its own FIB entry back
+  ndnGlobalRoutingHelper.RemoveOrigin("/p/o3", Names::Find<Node>("C9"));
+  aggregate();
+  BOOST_CHECK_EQUAL(getRouter("B9")->GetFibEntries().size(), 2);
+  BOOST_CHECK_EQUAL(getMatch("B9", "/p/o1"), Name("/p/o1"));
+  BOOST_CHECK_EQUAL(getMatch("B9", "/p/o4"), Name("/p/o4"));
+  BOOST_CHECK_EQUAL(getRouter("A9")->GetFibEntries().size(), 1);
+  BOOST_CHECK_EQUAL(getMatch("A9", "/p/o1"), Name("/p/o1"));
+}
+
+BOOST_AUTO_TEST_CASE(AggregateRoutesUnroutedSibling)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A13  NA  1 1 1\n"
+        << "B13  NA  80  -40 1\n"
+        << "C13  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A13      B13  10Mbps    1 1ms 100\n"
+        << "B13      C13  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  auto getRouter = [] (const std::string& node) {
+    return Names::Find<Node>(node)->GetObject<ndn::GlobalRouter>();
+  };
+  auto isForwarded = [] (const std::string& node, const std::string& name) {
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    return ndn->getForwarder()->getFib().findLongestPrefixMatch(name)->hasNextHops();
+  };
+
+  for (const std::string& node : {"A13", "B13", "C13"}) {
+    getRouter(node)->SetAttribute("AggregateRoutes", BooleanValue(true));
+  }
+
+  ndnGlobalRoutingHelper.AddOrigin("/p/o1", "C13");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o2", "C13");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o3", "C13");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  getRouter("A13")->AggregateRoutes();
+
+  // without CoverSiblings, names that have no route are still dropped
+  BOOST_CHECK_EQUAL(getRouter("A13")->GetFibEntries().size(), 3);
+  BOOST_CHECK(isForwarded("A13", "/p/o1/seg=0"));
+  BOOST_CHECK(!isForwarded("A13", "/p/o9/seg=0"));
+
+  ndnGlobalRoutingHelper.RemoveOrigin("/p/o2", Names::Find<Node>("C13"));
+  getRouter("A13")->AggregateRoutes();
+  BOOST_CHECK(!isForwarded("A13", "/p/o2/seg=0"));
+  BOOST_CHECK(isForwarded("A13", "/p/o3/seg=0"));
+
+  // with it, the cover for /p forwards them as well
+  getRouter("A13")->SetAttribute("CoverSiblings", BooleanValue(true));
+  ndnGlobalRoutingHelper.AddOrigin("/p/o4", "C13");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  getRouter("A13")->AggregateRoutes();
+  BOOST_CHECK(isForwarded("A13", "/p/o2/seg=0"));
+  BOOST_CHECK(isForwarded("A13", "/p/o9/seg=0"));
+}
+
+BOOST_AUTO_TEST_CASE(AggregateRoutesWithDefaultRoute)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A11  NA  1 1 1\n"
+        << "B11  NA  80  -40 1\n"
+        << "C11  NA  80  40  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A11      B11  10Mbps    1 1ms 100\n"
+        << "B11      C11  10Mbps    1 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.SetDefaultRoutes(true);
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+
+  auto getRouter = [] (const std::string& node) {
+    return Names::Find<Node>(node)->GetObject<ndn::GlobalRouter>();
+  };
+  auto getMatch = [] (const std::string& node, const std::string& name) {
+    auto ndn = Names::Find<Node>(node)->GetObject<ndn::L3Protocol>();
+    return ndn->getForwarder()->getFib().findLongestPrefixMatch(name)->getPrefix();
+  };
+
+  for (const std::string& node : {"A11", "B11", "C11"}) {
+    getRouter(node)->SetAttribute("AggregateRoutes", BooleanValue(true));
+    getRouter(node)->SetAttribute("CoverSiblings", BooleanValue(true));
+  }
+
+  ndnGlobalRoutingHelper.AddOrigin("/p/o1", "C11");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o2", "C11");
+  ndnGlobalRoutingHelper.AddOrigin("/p/o3", "C11");
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  getRouter("A11")->AggregateRoutes();
+
+  // a cover entry for /p would send names without a route of their own to C11 instead of
+  // following the default route
+  BOOST_CHECK_EQUAL(getRouter("A11")->GetFibEntries().size(), 3);
+  BOOST_CHECK_EQUAL(getMatch("A11", "/p/o1/seg=0"), Name("/p/o1"));
+  BOOST_CHECK_EQUAL(getMatch("A11", "/p/o9/seg=0"), Name("/"));
+
+  ndnGlobalRoutingHelper.RemoveOrigin("/p/o2", Names::Find<Node>("C11"));
+  getRouter("A11")->AggregateRoutes();
+  BOOST_CHECK_EQUAL(getMatch("A11", "/p/o2/seg=0"), Name("/"));
+}
+
+BOOST_AUTO_TEST_CASE(CalculateRoutesThreads)
+{
+  ofstream file1(TEST_TOPO_TXT.string().c_str());
+  file1 << "router\n\n"
+        << "#node city  y x mpi-partition\n"
+        << "A6  NA  1 1 1\n"
+        << "B6  NA  80  -40 1\n"
+        << "C6  NA  80  40  1\n"
+        << "D6  NA  1  80  1\n"
+        << "E6  NA  40  120  1\n\n"
+        << "link\n\n"
+        << "# from  to  capacity  metric  delay queue\n"
+        << "A6      B6  10Mbps    100 1ms 100\n"
+        << "A6      C6  10Mbps    50  1ms 100\n"
+        << "B6      C6  10Mbps    1 1ms 100\n"
+        << "C6      D6  10Mbps    5 1ms 100\n"
+        << "B6      E6  10Mbps    7 1ms 100\n"
+        << "D6      E6  10Mbps    3 1ms 100\n";
+  file1.close();
+
+  AnnotatedTopologyReader topologyReader("");
+  topologyReader.SetFileName(TEST_TOPO_TXT.string().c_str());
+  topologyReader.Read();
+
+  ndn::StackHelper ndnHelper;
+  ndnHelper.InstallAll();
+
+  topologyReader.ApplyOspfMetric();
+
+  ndn::GlobalRoutingHelper ndnGlobalRoutingHelper;
+  ndnGlobalRoutingHelper.InstallAll();
+  ndnGlobalRoutingHelper.AddOriginsForAll();
+
+  auto dumpFibs = [] {
+    std::set<std::string> fibs;
+    for (NodeList::Iterator node = NodeList::Begin(); node != NodeList::End(); node++) {
+      auto ndn = (*node)->GetObject<ndn::L3Protocol>();
+      for (const auto& entry : ndn->getForwarder()->getFib()) {
+        for (auto& nextHop : entry.getNextHops()) {
+          fibs.insert(Names::FindName(*node) + " " + entry.getPrefix().toUri() + " "
+                      + std::to_string(nextHop.getFace()->getId()) + " "
+                      + std::to_string(nextHop.getCost()));
+        }
+      }
+    }
+    return fibs;
+  };
+
+  GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(1));
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  std::set<std::string> serial = dumpFibs();
+  BOOST_CHECK(!serial.empty());
+
+  GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(4));
+  ndn::GlobalRoutingHelper::CalculateRoutes();
+  BOOST_CHECK(dumpFibs() == serial);
+
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  std::set<std::string> parallel = dumpFibs();
+  BOOST_CHECK(parallel.size() > serial.size());
+
+  GlobalValue::Bind("GlobalRoutingThreads", UintegerValue(1));
+  ndn::GlobalRoutingHelper::CalculateAllPossibleRoutes();
+  BOOST_CHECK(dumpFibs() == parallel);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
@@ -0,0 +1,154 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-hop-distance-oracle.hpp"
+#include "helper/ndn-global-routing-helper.hpp"
+#include "helper/ndn-link-control-helper.hpp"
+
+#include "ns3/core-module.h"
+#include "ns3/network-module.h"
+#include "ns3/ndnSIM-module.h"
+#include "ns3/point-to-point-module.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+class HopDistanceOracleFixture : public CleanupFixture
+{
+public:
+  HopDistanceOracleFixture()
+  {
+    // A - B - C - D - E, and F - C
+    nodes.Create(6);
+
+    PointToPointHelper p2p;
+    p2p.Install(nodes.Get(0), nodes.Get(1));
+    p2p.Install(nodes.Get(1), nodes.Get(2));
+    p2p.Install(nodes.Get(2), nodes.Get(3));
+    p2p.Install(nodes.Get(3), nodes.Get(4));
+    p2p.Install(nodes.Get(5), nodes.Get(2));
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+  }
+
+  ~HopDistanceOracleFixture()
+  {
+    GlobalValue::Bind("HopDistanceLandmarks", UintegerValue(0));
+  }
+
+public:
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HelperHopDistanceOracle, HopDistanceOracleFixture)
+
+BOOST_AUTO_TEST_CASE(Exact)
+{
+  HopDistanceOracle& oracle = HopDistanceOracle::Get();
+  BOOST_CHECK(oracle.IsExact());
+
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(0), nodes.Get(0)), 0);
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(0), nodes.Get(1)), 1);
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(0), nodes.Get(4)), 4);
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(4), nodes.Get(0)), 4);
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(5), nodes.Get(0)), 3);
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(5), nodes.Get(3)), 2);
+
+  // a node added later without GlobalRouter
+  Ptr<Node> isolated = CreateObject<Node>();
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(nodes.Get(0), isolated),
+                    HopDistanceOracle::UNREACHABLE);
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(isolated, isolated), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Landmarks)
+{
+  std::vector<uint16_t> exact;
+  for (uint32_t from = 0; from < nodes.GetN(); from++) {
+    for (uint32_t to = 0; to < nodes.GetN(); to++) {
+      exact.push_back(HopDistanceOracle::Get().GetDistance(nodes.Get(from), nodes.Get(to)));
+    }
+  }
+
+  GlobalValue::Bind("HopDistanceLandmarks", UintegerValue(2));
+  HopDistanceOracle& oracle = HopDistanceOracle::Get();
+  BOOST_CHECK(!oracle.IsExact());
+
+  // estimates are upper bounds, exact from and to landmarks (A first, then E farthest from A)
+  for (uint32_t from = 0; from < nodes.GetN(); from++) {
+    for (uint32_t to = 0; to < nodes.GetN(); to++) {
+      uint16_t distance = oracle.GetDistance(nodes.Get(from), nodes.Get(to));
+      BOOST_CHECK_GE(distance, exact[from * nodes.GetN() + to]);
+      if (from == 0 || to == 0 || from == 4 || to == 4)
+        BOOST_CHECK_EQUAL(distance, exact[from * nodes.GetN() + to]);
+    }
+  }
+
+  // B - D only over a landmark
+  BOOST_CHECK_EQUAL(oracle.GetDistance(nodes.Get(1), nodes.Get(3)), 4);
+}
+
+class FailedShortcutFixture : public CleanupFixture
+{
+public:
+  FailedShortcutFixture()
+  {
+    // A - B - C - D - E, and the shortcut A - E
+    nodes.Create(5);
+
+    PointToPointHelper p2p;
+    for (uint32_t i = 0; i + 1 < nodes.GetN(); i++)
+      p2p.Install(nodes.Get(i), nodes.Get(i + 1));
+    p2p.Install(nodes.Get(0), nodes.Get(4));
+
+    StackHelper ndnHelper;
+    ndnHelper.InstallAll();
+
+    GlobalRoutingHelper ndnGlobalRoutingHelper;
+    ndnGlobalRoutingHelper.InstallAll();
+  }
+
+public:
+  NodeContainer nodes;
+};
+
+BOOST_FIXTURE_TEST_CASE(FailedShortcut, FailedShortcutFixture)
+{
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(nodes.Get(0), nodes.Get(4)), 1);
+
+  // the topology does not change, only the link state
+  LinkControlHelper::FailLink(nodes.Get(0), nodes.Get(4));
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(nodes.Get(0), nodes.Get(4)), 4);
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(nodes.Get(4), nodes.Get(1)), 3);
+
+  LinkControlHelper::UpLink(nodes.Get(0), nodes.Get(4));
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(nodes.Get(0), nodes.Get(4)), 1);
+  BOOST_CHECK_EQUAL(HopDistanceOracle::Get().GetDistance(nodes.Get(4), nodes.Get(1)), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
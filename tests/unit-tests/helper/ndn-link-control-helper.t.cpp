@@ -148,6 +148,45 @@ BOOST_AUTO_TEST_CASE(SixNodeTopology) // Bug #2783
   Simulator::Run();
 }
 
+BOOST_AUTO_TEST_CASE(BatchToggling)
+{
+  createTopology({
+      {"1", "2"}, {"1", "3"},
+    });
+
+  getFace("1", "2")->setMetric(7);
+  uint64_t metric12 = getFace("1", "2")->getMetric();
+  uint64_t metric21 = getFace("2", "1")->getMetric();
+  uint64_t metric13 = getFace("1", "3")->getMetric();
+
+  LinkControlHelper::FailLinks({{getNode("1"), getNode("2")}, {getNode("3"), getNode("1")}});
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+  BOOST_CHECK_EQUAL(getFace("3", "1")->getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+
+  // metrics come back as they were before the links failed
+  LinkControlHelper::UpLinks({{getNode("1"), getNode("2")}, {getNode("1"), getNode("3")}});
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getMetric(), metric12);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getMetric(), metric21);
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getMetric(), metric13);
+
+  LinkControlHelper::FailLink(getNode("2"), getNode("1"));
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+  BOOST_CHECK_EQUAL(getFace("1", "3")->getMetric(), metric13);
+  LinkControlHelper::UpLink(getNode("1"), getNode("2"));
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getMetric(), 7);
+
+  // metric changed after the link was indexed, and a repeated failure, are kept
+  getFace("1", "2")->setMetric(9);
+  LinkControlHelper::FailLink(getNode("1"), getNode("2"));
+  LinkControlHelper::FailLink(getNode("1"), getNode("2"));
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getMetric(), std::numeric_limits<uint16_t>::max() - 1);
+  LinkControlHelper::UpLink(getNode("1"), getNode("2"));
+  BOOST_CHECK_EQUAL(getFace("1", "2")->getMetric(), 9);
+  BOOST_CHECK_EQUAL(getFace("2", "1")->getMetric(), metric21);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
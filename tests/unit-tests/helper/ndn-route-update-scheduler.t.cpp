@@ -0,0 +1,116 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "helper/ndn-route-update-scheduler.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(HelperNdnRouteUpdateScheduler, CleanupFixture)
+
+struct UpdateLog {
+  void
+  Record(uint32_t requests, uint32_t changes, Time staleness)
+  {
+    times.push_back(Simulator::Now());
+    counts.push_back(requests);
+    delays.push_back(staleness);
+  }
+
+  std::vector<Time> times;
+  std::vector<uint32_t> counts;
+  std::vector<Time> delays;
+};
+
+static void
+Request()
+{
+  RouteUpdateScheduler::Get()->RequestUpdate();
+}
+
+BOOST_AUTO_TEST_CASE(Coalescing)
+{
+  Ptr<RouteUpdateScheduler> scheduler = RouteUpdateScheduler::Get();
+  scheduler->SetAttribute("CoalescingWindow", StringValue("50ms"));
+  scheduler->SetAttribute("MaxStaleness", StringValue("1s"));
+
+  UpdateLog log;
+  scheduler->TraceConnectWithoutContext("Update", MakeCallback(&UpdateLog::Record, &log));
+
+  Simulator::Schedule(MilliSeconds(0), &Request);
+  Simulator::Schedule(MilliSeconds(10), &Request);
+  Simulator::Schedule(MilliSeconds(20), &Request);
+  Simulator::Schedule(MilliSeconds(500), &Request);
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(log.times.size(), 2);
+  BOOST_CHECK_EQUAL(log.times[0], MilliSeconds(70));
+  BOOST_CHECK_EQUAL(log.counts[0], 3);
+  BOOST_CHECK_EQUAL(log.delays[0], MilliSeconds(70));
+  BOOST_CHECK_EQUAL(log.times[1], MilliSeconds(550));
+  BOOST_CHECK_EQUAL(log.counts[1], 1);
+}
+
+BOOST_AUTO_TEST_CASE(MaxStaleness)
+{
+  Ptr<RouteUpdateScheduler> scheduler = RouteUpdateScheduler::Get();
+  scheduler->SetAttribute("CoalescingWindow", StringValue("50ms"));
+  scheduler->SetAttribute("MaxStaleness", StringValue("200ms"));
+
+  UpdateLog log;
+  scheduler->TraceConnectWithoutContext("Update", MakeCallback(&UpdateLog::Record, &log));
+
+  // a request every 40ms would postpone a plain debounce forever
+  for (int t = 0; t <= 240; t += 40) {
+    Simulator::Schedule(MilliSeconds(t), &Request);
+  }
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(log.times.size(), 2);
+  BOOST_CHECK_EQUAL(log.times[0], MilliSeconds(200));
+  BOOST_CHECK_EQUAL(log.counts[0], 6);
+  BOOST_CHECK_EQUAL(log.times[1], MilliSeconds(290));
+  BOOST_CHECK_EQUAL(log.counts[1], 1);
+}
+
+BOOST_AUTO_TEST_CASE(FlushAndCallbacks)
+{
+  Ptr<RouteUpdateScheduler> scheduler = RouteUpdateScheduler::Get();
+  scheduler->SetAttribute("CoalescingWindow", StringValue("50ms"));
+
+  int updated = 0;
+  scheduler->RequestUpdate([&updated] { updated++; });
+  scheduler->RequestUpdate([&updated] { updated++; });
+  BOOST_CHECK(scheduler->IsPending());
+  BOOST_CHECK_EQUAL(updated, 0);
+
+  scheduler->Flush();
+  BOOST_CHECK(!scheduler->IsPending());
+  BOOST_CHECK_EQUAL(updated, 2);
+
+  Simulator::Run();
+  BOOST_CHECK_EQUAL(updated, 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,171 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "model/cs/ndn-content-store.hpp"
+#include "helper/ndn-stack-helper.hpp"
+
+#include "ns3/object-factory.h"
+#include "ns3/uinteger.h"
+
+#include <ndn-cxx/interest.hpp>
+#include <ndn-cxx/data.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(ModelNdnContentStore, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(LookupShared)
+{
+  Ptr<ContentStore> cs = ObjectFactory("ns3::ndn::cs::Lru").Create<ContentStore>();
+
+  auto data = make_shared<Data>("/prefix/data");
+  data->setContent(make_shared< ::ndn::Buffer>(1024));
+  ndn::StackHelper::getKeyChain().sign(*data);
+  BOOST_CHECK(cs->Add(data));
+
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/other")) == nullptr);
+
+  // a hit hands back the stored Data
+  shared_ptr<const Data> hit = cs->Lookup(make_shared<Interest>("/prefix"));
+  BOOST_CHECK(hit == data);
+
+  // callers that modify the result get their own copy
+  shared_ptr<Data> copy = cs->Lookup(make_shared<Interest>("/prefix"));
+  BOOST_REQUIRE(copy != nullptr);
+  BOOST_CHECK(copy != data);
+  BOOST_CHECK(copy->wireEncode() == data->wireEncode());
+}
+
+BOOST_AUTO_TEST_CASE(EvictAndRefill)
+{
+  Ptr<ContentStore> cs = ObjectFactory("ns3::ndn::cs::Lru").Create<ContentStore>();
+  cs->SetAttribute("MaxSize", UintegerValue(10));
+
+  // evicted entries hand their trie nodes back to the slab allocator for the next ones
+  for (int round = 0; round < 3; round++) {
+    for (int i = 0; i < 20; i++) {
+      auto data = make_shared<Data>(Name("/prefix").append("r" + std::to_string(round))
+                                      .appendSequenceNumber(i));
+      ndn::StackHelper::getKeyChain().sign(*data);
+      cs->Add(data);
+    }
+    BOOST_CHECK_EQUAL(cs->GetSize(), 10u);
+
+    auto hit = cs->Lookup(make_shared<Interest>(Name("/prefix")
+                                                  .append("r" + std::to_string(round))
+                                                  .appendSequenceNumber(19)));
+    BOOST_CHECK(hit != nullptr);
+    BOOST_CHECK(cs->Lookup(make_shared<Interest>(Name("/prefix")
+                                                   .append("r" + std::to_string(round))
+                                                   .appendSequenceNumber(0))) == nullptr);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(RadixLru)
+{
+  Ptr<ContentStore> cs = ObjectFactory("ns3::ndn::cs::RadixLru").Create<ContentStore>();
+  cs->SetAttribute("MaxSize", UintegerValue(3));
+
+  for (const char* name : {"/prod1/obj1/%00%01", "/prod1/obj1/%00%02", "/prod1/obj2/%00%01"}) {
+    auto data = make_shared<Data>(name);
+    ndn::StackHelper::getKeyChain().sign(*data);
+    BOOST_CHECK(cs->Add(data));
+  }
+
+  // lookups ending inside and at the end of collapsed spans
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prod1/obj1/%00%02")) != nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prod1/obj2")) != nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prod1/obj")) == nullptr);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prod1/obj2/%00%01/more")) == nullptr);
+
+  auto interest = make_shared<Interest>("/prod1");
+  interest->setExclude(Exclude().excludeOne(name::Component("obj1")));
+  auto hit = cs->Lookup(interest);
+  BOOST_REQUIRE(hit != nullptr);
+  BOOST_CHECK_EQUAL(hit->getName(), Name("/prod1/obj2/%00%01"));
+
+  // least recently used entry goes first, and enumeration sees the remaining ones
+  auto data = make_shared<Data>("/prod2/obj1/%00%01");
+  ndn::StackHelper::getKeyChain().sign(*data);
+  BOOST_CHECK(cs->Add(data));
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>("/prod1/obj1/%00%01")) == nullptr);
+
+  size_t nEntries = 0;
+  for (Ptr<cs::Entry> entry = cs->Begin(); entry != cs->End(); entry = cs->Next(entry)) {
+    nEntries++;
+  }
+  BOOST_CHECK_EQUAL(nEntries, 3u);
+}
+
+struct BytesUsedLog {
+  void
+  Record(uint32_t oldValue, uint32_t newValue)
+  {
+    bytesUsed = newValue;
+  }
+
+  uint32_t bytesUsed = 0;
+};
+
+BOOST_AUTO_TEST_CASE(ByteCapacity)
+{
+  Ptr<ContentStore> cs = ObjectFactory("ns3::ndn::cs::Lru").Create<ContentStore>();
+  cs->SetAttribute("MaxSize", UintegerValue(0));
+
+  BytesUsedLog log;
+  cs->TraceConnectWithoutContext("BytesUsed", MakeCallback(&BytesUsedLog::Record, &log));
+
+  // vicinity replies and chunks of different sizes
+  std::vector<shared_ptr<Data>> data;
+  for (size_t payloadSize : {1024, 8192, 1024}) {
+    data.push_back(make_shared<Data>(Name("/prefix").appendSequenceNumber(data.size())));
+    data.back()->setContent(make_shared< ::ndn::Buffer>(payloadSize));
+    ndn::StackHelper::getKeyChain().sign(*data.back());
+  }
+  uint32_t size0 = data[0]->wireEncode().size();
+  uint32_t size1 = data[1]->wireEncode().size();
+  uint32_t size2 = data[2]->wireEncode().size();
+
+  cs->SetAttribute("MaxBytes", UintegerValue(size0 + size1));
+  BOOST_CHECK(cs->Add(data[0]));
+  BOOST_CHECK(cs->Add(data[1]));
+  BOOST_CHECK_EQUAL(log.bytesUsed, size0 + size1);
+
+  // the oldest entry goes to make room
+  BOOST_CHECK(cs->Add(data[2]));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2u);
+  BOOST_CHECK_EQUAL(log.bytesUsed, size1 + size2);
+  BOOST_CHECK(cs->Lookup(make_shared<Interest>(data[0]->getName())) == nullptr);
+
+  // an entry larger than the whole capacity is not cached
+  auto chunk = make_shared<Data>("/prefix/chunk");
+  chunk->setContent(make_shared< ::ndn::Buffer>(8192));
+  ndn::StackHelper::getKeyChain().sign(*chunk);
+  cs->SetAttribute("MaxBytes", UintegerValue(size0));
+  BOOST_CHECK(!cs->Add(chunk));
+  BOOST_CHECK_EQUAL(cs->GetSize(), 2u);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -54,6 +54,74 @@ BOOST_AUTO_TEST_CASE(ToPacket)
   BOOST_CHECK_EQUAL(type2, ::ndn::tlv::Data);
 }
 
+BOOST_AUTO_TEST_CASE(FromPacket)
+{
+  auto data = std::make_shared<ndn::Data>("/prefix/data");
+  data->setFreshnessPeriod(ndn::time::milliseconds(1000));
+  data->setContent(std::make_shared< ::ndn::Buffer>(8192));
+  ndn::StackHelper::getKeyChain().sign(*data);
+
+  Ptr<Packet> packet = Convert::ToPacket(*data);
+  uint32_t size = packet->GetSize();
+
+  auto decoded = Convert::FromPacket<Data>(packet);
+  BOOST_CHECK(decoded->wireEncode() == data->wireEncode());
+
+  // received packet is shared, not stripped
+  BOOST_CHECK_EQUAL(packet->GetSize(), size);
+  auto tag = decoded->getTag<Ns3PacketTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->getHeaderSize(), size);
+
+  Ptr<Packet> forwarded = Convert::ToPacket(*decoded);
+  BOOST_CHECK_EQUAL(forwarded->GetSize(), size);
+
+  Ptr<Packet> truncated = packet->CreateFragment(0, size - 1);
+  BOOST_CHECK_THROW(Convert::FromPacket<Data>(truncated), ::ndn::tlv::Error);
+}
+
+BOOST_AUTO_TEST_CASE(ToPacketCached)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  Ptr<Packet> packet1 = Convert::ToPacket(*interest);
+
+  auto tag = interest->getTag<Ns3PacketTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK(tag->isHeaderOf(interest->wireEncode()));
+
+  // unmodified Interest reuses the serialized packet
+  Ptr<Packet> packet2 = Convert::ToPacket(*interest);
+  BOOST_CHECK_EQUAL(packet1->GetSize(), packet2->GetSize());
+  BOOST_CHECK(interest->getTag<Ns3PacketTag>() == tag);
+
+  // modified Interest is serialized again
+  interest->setName("/other/prefix");
+  Ptr<Packet> packet3 = Convert::ToPacket(*interest);
+  BOOST_CHECK(interest->getTag<Ns3PacketTag>() != tag);
+  BOOST_CHECK(Convert::FromPacket<Interest>(packet3)->getName() == Name("/other/prefix"));
+}
+
+BOOST_AUTO_TEST_CASE(HopCount)
+{
+  auto interest = make_shared<ndn::Interest>("/prefix");
+  Ptr<Packet> packet = Convert::ToPacket(*interest);
+  BOOST_CHECK_EQUAL(interest->getTag<Ns3PacketTag>()->getHopCount(), 0);
+
+  FwHopCountTag hopCountTag;
+  hopCountTag.Set(3);
+  packet->AddPacketTag(hopCountTag);
+
+  auto received = Convert::FromPacket<Interest>(packet);
+  auto tag = received->getTag<Ns3PacketTag>();
+  BOOST_REQUIRE(tag != nullptr);
+  BOOST_CHECK_EQUAL(tag->getHopCount(), 3);
+
+  // forwarded copies carry the hop count of the received packet
+  Ptr<Packet> forwarded = Convert::ToPacket(*received);
+  BOOST_CHECK(forwarded->PeekPacketTag(hopCountTag));
+  BOOST_CHECK_EQUAL(hopCountTag.Get(), 3);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace ndn
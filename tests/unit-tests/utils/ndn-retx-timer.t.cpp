@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-retx-timer.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnRetxTimer, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(FixedTimeout)
+{
+  RetxTimer<uint32_t> timer;
+  std::vector<std::pair<Time, std::vector<uint32_t>>> batches;
+  timer.SetCallback([&batches] (const std::vector<uint32_t>& expired) {
+      batches.push_back(std::make_pair(Simulator::Now(), expired));
+    });
+  timer.SetTimeout(Seconds(1));
+
+  typedef RetxTimer<uint32_t> Timer;
+  Simulator::Schedule(Seconds(0.0), &Timer::Add, &timer, 1);
+  Simulator::Schedule(Seconds(0.0), &Timer::Add, &timer, 2);
+  Simulator::Schedule(Seconds(0.0), &Timer::Add, &timer, 3);
+  Simulator::Schedule(Seconds(0.5), &Timer::Remove, &timer, 2);
+  Simulator::Schedule(Seconds(0.5), &Timer::Add, &timer, 4);
+  Simulator::Schedule(Seconds(0.8), &Timer::Add, &timer, 1); // re-sent
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(batches.size(), 3);
+  BOOST_CHECK_EQUAL(batches[0].first, Seconds(1));
+  BOOST_CHECK_EQUAL_COLLECTIONS(batches[0].second.begin(), batches[0].second.end(),
+                                std::vector<uint32_t>{3}.begin(), std::vector<uint32_t>{3}.end());
+  BOOST_CHECK_EQUAL(batches[1].first, Seconds(1.5));
+  BOOST_CHECK_EQUAL(batches[1].second.at(0), 4);
+  BOOST_CHECK_EQUAL(batches[2].first, Seconds(1.8));
+  BOOST_CHECK_EQUAL(batches[2].second.at(0), 1);
+  BOOST_CHECK_EQUAL(timer.GetSize(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(Polling)
+{
+  RetxTimer<uint32_t> timer;
+  std::vector<uint32_t> expired;
+  timer.SetCallback([&expired] (const std::vector<uint32_t>& batch) {
+      expired.insert(expired.end(), batch.begin(), batch.end());
+    });
+
+  typedef RetxTimer<uint32_t> Timer;
+  Simulator::Schedule(Seconds(0.0), &Timer::Add, &timer, 10);
+  Simulator::Schedule(Seconds(0.2), &Timer::Add, &timer, 11);
+  Simulator::Schedule(Seconds(1.1), &Timer::Expire, &timer, Seconds(1));
+  Simulator::Run();
+
+  BOOST_REQUIRE_EQUAL(expired.size(), 1);
+  BOOST_CHECK_EQUAL(expired[0], 10);
+  BOOST_CHECK(timer.IsPending(11));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
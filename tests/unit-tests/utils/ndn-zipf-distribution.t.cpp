@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/ndn-zipf-distribution.hpp"
+
+#include "../tests-common.hpp"
+
+#include <cmath>
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsNdnZipfDistribution, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Probabilities)
+{
+  ZipfDistribution zipf(100, 0.7, 0.7);
+
+  double normalizer = 0;
+  for (uint32_t k = 1; k <= 100; k++) {
+    normalizer += std::pow(k + 0.7, -0.7);
+  }
+  BOOST_CHECK_CLOSE(zipf.GetNormalizer(), normalizer, 1e-9);
+
+  for (uint32_t k = 1; k <= 100; k++) {
+    BOOST_CHECK_CLOSE(zipf.GetProbability(k), std::pow(k + 0.7, -0.7) / normalizer, 1e-9);
+  }
+  BOOST_CHECK_CLOSE(zipf.GetCumulativeProbability(100), 1.0, 1e-9);
+  BOOST_CHECK_CLOSE(zipf.GetProbability(200), std::pow(200.7, -0.7) / normalizer, 1e-9);
+}
+
+BOOST_AUTO_TEST_CASE(Sampling)
+{
+  ZipfDistribution zipf(100, 0, 1);
+
+  BOOST_CHECK_EQUAL(zipf.GetRank(1e-12), 1);
+  BOOST_CHECK_EQUAL(zipf.GetRank(zipf.GetCumulativeProbability(1)), 1);
+  BOOST_CHECK_EQUAL(zipf.GetRank(zipf.GetCumulativeProbability(1) + 1e-12), 2);
+  BOOST_CHECK_EQUAL(zipf.GetRank(zipf.GetCumulativeProbability(42)), 42);
+  BOOST_CHECK_EQUAL(zipf.GetRank(1.0), 100);
+
+  // linear scan, as the consumer used to do
+  for (double u = 0.001; u < 1.0; u += 0.001) {
+    uint32_t expected = 1;
+    for (uint32_t k = 1; k <= 100; k++) {
+      if (u <= zipf.GetCumulativeProbability(k)) {
+        expected = k;
+        break;
+      }
+    }
+    BOOST_CHECK_EQUAL(zipf.GetRank(u), expected);
+  }
+}
+
+BOOST_AUTO_TEST_CASE(Sharing)
+{
+  std::shared_ptr<const ZipfDistribution> a = ZipfDistribution::Get(1000, 0.7, 0.7);
+  std::shared_ptr<const ZipfDistribution> b = ZipfDistribution::Get(1000, 0.7, 0.7);
+  std::shared_ptr<const ZipfDistribution> c = ZipfDistribution::Get(1000, 0.7, 0.8);
+
+  BOOST_CHECK(a == b);
+  BOOST_CHECK(a != c);
+  BOOST_CHECK_EQUAL(a->GetN(), 1000);
+  BOOST_CHECK_EQUAL(c->GetS(), 0.8);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,72 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/pdrm-catalog.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsPdrmCatalog, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(InternedLookup)
+{
+  Ptr<PDRMCatalog> catalog = CreateObject<PDRMCatalog>();
+  catalog->setObjectSize(10);
+  catalog->initializeCatalog(4, 0.8);
+
+  catalog->addObject(Name("/p/o0"), 2);
+  catalog->addObject(Name("/p/o1"), 0);
+
+  BOOST_CHECK_EQUAL(catalog->getObjectPopularity(Name("/p/o0")), 2);
+  BOOST_CHECK_EQUAL(catalog->getObjectPopularity(Name("/p/o1")), 0);
+  BOOST_CHECK_EQUAL(catalog->getObjectPopularity(Name("/p/unknown")), 0);
+
+  const ContentObject& object = catalog->getObject(Name("/p/o0"));
+  BOOST_CHECK_EQUAL(object.name, Name("/p/o0"));
+  BOOST_CHECK_EQUAL(object.size, 10);
+  BOOST_CHECK_EQUAL(&object, &catalog->getObject(2));
+
+  // empty slots and out-of-range indexes yield an empty object
+  BOOST_CHECK(catalog->getObject(1).name.empty());
+  BOOST_CHECK_EQUAL(catalog->getObject(1).size, 0);
+  BOOST_CHECK(catalog->getObject(100).name.empty());
+}
+
+BOOST_AUTO_TEST_CASE(Requests)
+{
+  Ptr<PDRMCatalog> catalog = CreateObject<PDRMCatalog>();
+  catalog->setObjectSize(1);
+  catalog->initializeCatalog(3, 1.0);
+  catalog->addObject(Name("/p/a"), 0);
+  catalog->addObject(Name("/p/b"), 1);
+  catalog->addObject(Name("/p/c"), 2);
+
+  for (int i = 0; i < 100; i++) {
+    BOOST_CHECK(!catalog->getObjectRequest().name.empty());
+  }
+
+  BOOST_CHECK_CLOSE(catalog->getRequestProbability(Name("/p/b")) / 20, 1.0 / (1 + 0.5 + 1.0 / 3), 1e-9);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
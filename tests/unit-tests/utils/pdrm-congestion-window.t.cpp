@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/pdrm-congestion-window.hpp"
+
+#include "ns3/uinteger.h"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsPdrmCongestionWindow, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Fixed)
+{
+  Ptr<PDRMCongestionWindow> window = CreateObject<PDRMFixedWindow>();
+  BOOST_CHECK_EQUAL(window->GetWindow(), std::numeric_limits<uint32_t>::max());
+
+  window->SetAttribute("Window", UintegerValue(8));
+  window->OnTimeout(Seconds(0.1));
+  window->OnData(Seconds(0.1));
+  BOOST_CHECK_EQUAL(window->GetWindow(), 8);
+}
+
+BOOST_AUTO_TEST_CASE(Aimd)
+{
+  Ptr<PDRMCongestionWindow> window = CreateObject<PDRMAimdWindow>();
+  BOOST_CHECK_EQUAL(window->GetWindow(), 1);
+
+  // slow start
+  for (int i = 0; i < 15; i++) {
+    window->OnData(Seconds(0.1));
+  }
+  BOOST_CHECK_EQUAL(window->GetWindow(), 16);
+
+  // only the first timeout within an RTT halves the window
+  window->OnTimeout(Seconds(0.1));
+  window->OnTimeout(Seconds(0.1));
+  BOOST_CHECK_EQUAL(window->GetWindow(), 8);
+
+  // congestion avoidance: about one more Interest per window
+  for (int i = 0; i < 8; i++) {
+    window->OnData(Seconds(0.1));
+  }
+  BOOST_CHECK_EQUAL(window->GetWindow(), 8);
+  window->OnData(Seconds(0.1));
+  BOOST_CHECK_EQUAL(window->GetWindow(), 9);
+}
+
+BOOST_AUTO_TEST_CASE(Cubic)
+{
+  Ptr<PDRMCongestionWindow> window = CreateObject<PDRMCubicWindow>();
+  window->SetAttribute("InitialWindow", UintegerValue(20));
+
+  window->OnTimeout(Seconds(0.1));
+  BOOST_CHECK_EQUAL(window->GetWindow(), 14);
+
+  // grows back towards the window before the reduction
+  for (int i = 0; i < 100; i++) {
+    window->OnData(Seconds(0.1));
+  }
+  BOOST_CHECK_GE(window->GetWindow(), 14);
+  BOOST_CHECK_LE(window->GetWindow(), 20);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
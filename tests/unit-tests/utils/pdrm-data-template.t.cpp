@@ -0,0 +1,83 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/pdrm-data-template.hpp"
+
+#include <ndn-cxx/data.hpp>
+#include <ndn-cxx/name.hpp>
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsPdrmDataTemplate, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(Create)
+{
+  PDRMDataTemplate dataTemplate(1024, Seconds(2), 42, Name("/key/locator"));
+
+  // Reference packet built the same way the apps used to build it
+  Data reference(Name("/prod/object").appendSequenceNumber(7));
+  reference.setFreshnessPeriod(::ndn::time::milliseconds(2000));
+  reference.setContent(make_shared< ::ndn::Buffer>(1024));
+
+  Signature signature;
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+  signatureInfo.setKeyLocator(Name("/key/locator"));
+  signature.setInfo(signatureInfo);
+  signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, 42));
+  reference.setSignature(signature);
+
+  auto data = dataTemplate.create(Name("/prod/object"), 7);
+
+  BOOST_CHECK_EQUAL(data->getName(), reference.getName());
+  BOOST_CHECK_EQUAL(data->getFreshnessPeriod(), ::ndn::time::milliseconds(2000));
+  BOOST_CHECK_EQUAL(data->getContent().value_size(), 1024);
+  BOOST_CHECK_EQUAL(data->getSignature().getKeyLocator().getName(), Name("/key/locator"));
+
+  const Block& expected = reference.wireEncode();
+  const Block& actual = data->wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(Unsolicited)
+{
+  PDRMDataTemplate dataTemplate(1024, Seconds(2), 42, Name(), true);
+
+  Data reference(Name("/prod/object").appendSequenceNumber(3));
+  reference.setFreshnessPeriod(::ndn::time::milliseconds(2000));
+  reference.setContent(make_shared< ::ndn::Buffer>(1024));
+  reference.setSignature(dataTemplate.getSignature());
+  reference.setUnsolicited(true);
+
+  auto data = dataTemplate.create(Name("/prod/object"), 3);
+
+  // the flag is part of the pre-encoded suffix, the packet is not encoded again
+  const uint8_t* wire = data->wireEncode().wire();
+  const Block& expected = reference.wireEncode();
+  const Block& actual = data->wireEncode();
+  BOOST_CHECK_EQUAL_COLLECTIONS(actual.begin(), actual.end(), expected.begin(), expected.end());
+  BOOST_CHECK(data->wireEncode().wire() == wire);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,109 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "utils/pdrm-download-state.hpp"
+
+#include "../tests-common.hpp"
+
+namespace ns3 {
+namespace ndn {
+
+BOOST_FIXTURE_TEST_SUITE(UtilsPdrmDownloadState, CleanupFixture)
+
+BOOST_AUTO_TEST_CASE(ChunkTransitions)
+{
+  PDRMDownloadState state;
+  BOOST_CHECK(!state.isDownloading(Name("/p/o")));
+
+  uint32_t id = state.startObject(Name("/p/o"), 3);
+  BOOST_CHECK(state.isDownloading(Name("/p/o")));
+  BOOST_CHECK_EQUAL(state.getObjectId(Name("/p/o")), id);
+  BOOST_CHECK_EQUAL(state.getObject(id).size, 3);
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 0);
+
+  uint32_t seqNumber = 0;
+  BOOST_CHECK_EQUAL(state.getChunkId(Name("/p/o").appendSequenceNumber(2), seqNumber), id);
+  BOOST_CHECK_EQUAL(seqNumber, 2);
+  BOOST_CHECK_EQUAL(state.getChunkId(Name("/p/o").appendSequenceNumber(3), seqNumber),
+                    PDRMDownloadState::INVALID_ID);
+  BOOST_CHECK_EQUAL(state.getChunkId(Name("/p/x").appendSequenceNumber(0), seqNumber),
+                    PDRMDownloadState::INVALID_ID);
+
+  // requested -> pending, retransmissions do not count twice
+  state.recordRequest(id, 0);
+  state.recordRequest(id, 0);
+  state.recordRequest(id, 1);
+  BOOST_CHECK(state.isPending(id, 0));
+  BOOST_CHECK_EQUAL(state.getChunk(id, 0).requestCount, 2);
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 2);
+
+  // cleared -> not pending
+  state.clearChunk(id, 1);
+  BOOST_CHECK(!state.isPending(id, 1));
+  BOOST_CHECK_EQUAL(state.getChunk(id, 1).requestCount, 0);
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 1);
+
+  // received -> neither pending nor requested again
+  BOOST_CHECK(!state.markReceived(id, 0));
+  BOOST_CHECK(state.isReceived(id, 0));
+  BOOST_CHECK(!state.isPending(id, 0));
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 0);
+
+  state.recordRequest(id, 1);
+  state.recordRequest(id, 2);
+  BOOST_CHECK(!state.markReceived(id, 1));
+  BOOST_CHECK(state.markReceived(id, 2));
+  BOOST_CHECK_EQUAL(state.getObject(id).downloaded, 3);
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 0);
+}
+
+BOOST_AUTO_TEST_CASE(ConcludeAndReuse)
+{
+  PDRMDownloadState state;
+  uint32_t a = state.startObject(Name("/p/b"), 2);
+  uint32_t b = state.startObject(Name("/p/a"), 2);
+  state.recordRequest(a, 0);
+  state.recordRequest(a, 1);
+  state.recordRequest(b, 0);
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 3);
+
+  std::vector<uint32_t> ids = state.getObjectIds();
+  BOOST_REQUIRE_EQUAL(ids.size(), 2);
+  BOOST_CHECK_EQUAL(ids[0], b);
+  BOOST_CHECK_EQUAL(ids[1], a);
+
+  // concluding drops pending chunks of the object
+  state.concludeObject(a);
+  BOOST_CHECK(!state.isDownloading(Name("/p/b")));
+  BOOST_CHECK_EQUAL(state.getPendingCount(), 1);
+
+  // freed id is reused with fresh chunk records
+  uint32_t c = state.startObject(Name("/p/c"), 4);
+  BOOST_CHECK_EQUAL(c, a);
+  BOOST_CHECK_EQUAL(state.getObject(c).name, Name("/p/c"));
+  BOOST_CHECK_EQUAL(state.getObject(c).downloaded, 0);
+  BOOST_CHECK(!state.isPending(c, 0));
+  BOOST_CHECK(!state.isReceived(c, 1));
+  BOOST_CHECK_EQUAL(state.getObjectIds().size(), 2);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace ndn
+} // namespace ns3
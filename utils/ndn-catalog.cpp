@@ -146,11 +146,11 @@ Catalog::initializeCatalog()
 void
 Catalog::initializePopularity()
 {
-  m_objectPopularityBase = 0;
+  m_objectPopularityDistribution = ZipfDistribution::Get(m_userPopulationSize, 0,
+                                                         m_objectPopularityAlpha);
   for (uint32_t k = 1; k <= m_userPopulationSize; k++)
   {
     m_popularityIndex.push_back(k);
-    m_objectPopularityBase += pow(k, -1*m_objectPopularityAlpha);
   }
   random_shuffle(m_popularityIndex.begin(), m_popularityIndex.end());
 }
@@ -203,7 +203,7 @@ Catalog::getNextPopularity()
 double
 Catalog::getPopularity(uint32_t rank)
 {
-  return pow(rank, -1*m_objectPopularityAlpha)/m_objectPopularityBase;
+  return m_objectPopularityDistribution->GetProbability(rank);
 }
 
 double
@@ -238,7 +238,7 @@ Catalog::getNextObjectAvailability()
 //}
 
 void
-Catalog::addObject(Name objectName, double popularity)
+Catalog::addObject(const Name& objectName, double popularity)
 {
   objectProperties properties;
 
@@ -247,19 +247,46 @@ Catalog::addObject(Name objectName, double popularity)
   properties.availability = getNextObjectAvailability();
 //  properties.lifetime = getNextObjectLifetime();
 
-  m_objects[objectName] = properties;
+  unordered_map<Name, uint32_t, NameHash>::iterator it = m_objectIds.find(objectName);
+  if (it != m_objectIds.end()) {
+    m_objects[it->second] = properties;
+    return;
+  }
+
+  uint32_t id;
+  if (!m_freeObjectIds.empty()) {
+    id = m_freeObjectIds.back();
+    m_freeObjectIds.pop_back();
+    m_objects[id] = properties;
+  }
+  else {
+    id = m_objects.size();
+    m_objects.push_back(properties);
+  }
+  m_objectIds[objectName] = id;
 }
 
-objectProperties
-Catalog::getObjectProperties(Name objectName)
+const objectProperties&
+Catalog::getObjectProperties(const Name& objectName) const
 {
-  return m_objects[objectName];
+  static const objectProperties UNKNOWN = objectProperties();
+
+  unordered_map<Name, uint32_t, NameHash>::const_iterator it = m_objectIds.find(objectName);
+  if (it == m_objectIds.end())
+    return UNKNOWN;
+
+  return m_objects[it->second];
 }
 
 void
-Catalog::removeObject(Name objectName)
+Catalog::removeObject(const Name& objectName)
 {
-  m_objects.erase(objectName);
+  unordered_map<Name, uint32_t, NameHash>::iterator it = m_objectIds.find(objectName);
+  if (it == m_objectIds.end())
+    return;
+
+  m_freeObjectIds.push_back(it->second);
+  m_objectIds.erase(it);
 }
 
 } // namespace ndn
@@ -25,8 +25,13 @@
 #include "ns3/core-module.h"
 #include "ns3/network-module.h"
 
+#include "ndn-name-hash.hpp"
+#include "ndn-zipf-distribution.hpp"
+
 #include <ndn-cxx/name.hpp>
 #include <list>
+#include <memory>
+#include <unordered_map>
 #include <vector>
 
 using namespace std;
@@ -95,13 +100,18 @@ public:
   initializeCatalog();
 
   void
-  addObject(Name objectName, double popularity);
+  addObject(const Name& objectName, double popularity);
 
-  objectProperties
-  getObjectProperties(Name objectName);
+  /**
+   * @brief Get the properties of the object, all zero if the object is unknown
+   *
+   * The reference stays valid until the next call to addObject.
+   */
+  const objectProperties&
+  getObjectProperties(const Name& objectName) const;
 
   void
-  removeObject(Name objectName);
+  removeObject(const Name& objectName);
 
   double
   getUserPopularity();
@@ -153,7 +163,7 @@ private:
 
   double m_maxRequests;
   double m_objectPopularityAlpha;
-  double m_objectPopularityBase;
+  std::shared_ptr<const ZipfDistribution> m_objectPopularityDistribution;
   double m_objectPopularityStddev;
 
   double m_objectSizeMean;
@@ -165,7 +175,10 @@ private:
 //  double m_objectLifetimeMean;
 //  double m_objectLifetimeStddev;
 
-  map<Name, objectProperties> m_objects;
+  // objects are interned: properties live in a dense vector, indexed by an id from the name index
+  vector<objectProperties> m_objects;
+  unordered_map<Name, uint32_t, NameHash> m_objectIds;
+  vector<uint32_t> m_freeObjectIds;
 };
 
 } // namespace ndn
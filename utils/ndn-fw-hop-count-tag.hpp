@@ -65,6 +65,17 @@ public:
     return m_hopCount;
   }
 
+  /* PDRM Change */
+  /**
+   * @brief Set value of hop count
+   */
+  void
+  Set(uint32_t hopCount)
+  {
+    m_hopCount = hopCount;
+  }
+  /* PDRM Change */
+
   ////////////////////////////////////////////////////////
   // from ObjectBase
   ////////////////////////////////////////////////////////
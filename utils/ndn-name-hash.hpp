@@ -0,0 +1,48 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_NAME_HASH_H
+#define NDN_NAME_HASH_H
+
+#include <ndn-cxx/name.hpp>
+
+#include <boost/functional/hash.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Hash functor to use ::ndn::Name as a key of unordered containers
+ *
+ * The hash is computed over the (cached) TLV encoding of the name.
+ */
+struct NameHash {
+  size_t
+  operator()(const ::ndn::Name& name) const
+  {
+    const ::ndn::Block& wire = name.wireEncode();
+    return boost::hash_range(wire.value_begin(), wire.value_end());
+  }
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_NAME_HASH_H
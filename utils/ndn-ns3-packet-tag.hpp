@@ -22,7 +22,11 @@
 
 #include "ns3/packet.h"
 #include "ns3/ptr.h"
+#include "ndn-fw-hop-count-tag.hpp"
 #include <ndn-cxx/tag.hpp>
+#include <ndn-cxx/encoding/block.hpp>
+
+#include <limits>
 
 namespace ns3 {
 namespace ndn {
@@ -35,10 +39,19 @@ public:
     return 0xaee87802; // md5("Ns3PacketTag")[0:8]
   }
 
-  Ns3PacketTag(Ptr<const Packet> packet)
+  /* PDRM Change */
+  /**
+   * @param packet ns-3 packet that carries (or carried) the NDN packet
+   * @param wire   wire encoding of the NDN packet serialized at the start of the ns-3 packet
+   *               (empty if the ns-3 packet has no NDN header)
+   */
+  Ns3PacketTag(Ptr<const Packet> packet, const ::ndn::Block& wire = ::ndn::Block())
     : m_packet(packet)
+    , m_wire(wire)
+    , m_hopCount(UNKNOWN_HOP_COUNT)
   {
   }
+  /* PDRM Change */
 
   Ptr<const Packet>
   getPacket() const
@@ -46,8 +59,59 @@ public:
     return m_packet;
   }
 
+  /* PDRM Change */
+  /**
+   * @brief Get size of the NDN header at the start of the packet
+   */
+  uint32_t
+  getHeaderSize() const
+  {
+    return m_wire.hasWire() ? m_wire.size() : 0;
+  }
+
+  /**
+   * @brief Check whether the NDN header of the packet is still the current encoding @p wire
+   *
+   * The tag keeps the wire buffer alive, so the buffer identity check cannot be fooled by a
+   * re-encoding that reuses freed memory
+   */
+  bool
+  isHeaderOf(const ::ndn::Block& wire) const
+  {
+    return m_wire.hasWire() && wire.hasWire() && m_wire.wire() == wire.wire()
+           && m_wire.size() == wire.size();
+  }
+
+  /**
+   * @brief Get number of NetDeviceFace transmissions of the packet so far (FwHopCountTag)
+   *
+   * The packet tag is looked up once, then the value is kept in this tag: applications and every
+   * face forwarding the packet read it from here
+   *
+   * @returns 0 if the packet has not crossed any link
+   */
+  uint32_t
+  getHopCount() const
+  {
+    if (m_hopCount == UNKNOWN_HOP_COUNT) {
+      FwHopCountTag hopCountTag;
+      m_hopCount = m_packet->PeekPacketTag(hopCountTag) ? hopCountTag.Get() : 0;
+    }
+    return m_hopCount;
+  }
+  /* PDRM Change */
+
 private:
+  /* PDRM Change */
+  static const uint32_t UNKNOWN_HOP_COUNT = std::numeric_limits<uint32_t>::max();
+  /* PDRM Change */
+
+
   Ptr<const Packet> m_packet;
+  /* PDRM Change */
+  ::ndn::Block m_wire;
+  mutable uint32_t m_hopCount;
+  /* PDRM Change */
 };
 
 } // namespace ndn
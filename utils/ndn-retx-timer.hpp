@@ -0,0 +1,194 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_RETX_TIMER_H
+#define NDN_RETX_TIMER_H
+
+#include "ns3/nstime.h"
+#include "ns3/simulator.h"
+#include "ns3/event-id.h"
+
+#include <deque>
+#include <functional>
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Retransmission timer for Interests sent by an application
+ *
+ * Keeps outstanding Interests (identified by @p Key) in the order they were sent.  Instead of
+ * one simulator event per Interest, expired Interests are reported in batches through a single
+ * callback, either when the application polls the timer (Expire) or, if a fixed timeout is
+ * set, from one event per application that is lazily re-armed for the oldest Interest.
+ *
+ * Removal is lazy as well: a removed or re-sent Interest leaves a stale entry in the send
+ * queue, which is dropped once it reaches the head of the queue.
+ */
+template<class Key, class Hash = std::hash<Key>>
+class RetxTimer {
+public:
+  typedef std::function<void(const std::vector<Key>&)> ExpireCallback;
+
+  RetxTimer()
+    : m_timeout(Seconds(0))
+  {
+  }
+
+  /**
+   * @brief Set callback to be invoked with the keys of expired Interests, in send order
+   */
+  void
+  SetCallback(const ExpireCallback& callback)
+  {
+    m_callback = callback;
+  }
+
+  /**
+   * @brief Set fixed timeout and let the timer schedule its own expiration event
+   *
+   * If timeout is zero (default), expiration has to be triggered using Expire.
+   */
+  void
+  SetTimeout(Time timeout)
+  {
+    m_timeout = timeout;
+    Arm();
+  }
+
+  /**
+   * @brief Start (or restart) the timeout of @p key at the current time
+   */
+  void
+  Add(const Key& key)
+  {
+    Time now = Simulator::Now();
+    m_pending[key] = now;
+    m_queue.push_back(Entry{now, key});
+    Arm();
+  }
+
+  /**
+   * @brief Stop the timeout of @p key, e.g., when Data is received
+   */
+  void
+  Remove(const Key& key)
+  {
+    m_pending.erase(key);
+    if (m_pending.empty()) {
+      Cancel();
+    }
+  }
+
+  bool
+  IsPending(const Key& key) const
+  {
+    return m_pending.count(key) > 0;
+  }
+
+  size_t
+  GetSize() const
+  {
+    return m_pending.size();
+  }
+
+  /**
+   * @brief Report all Interests sent at least @p timeout ago
+   * @returns number of expired Interests
+   */
+  size_t
+  Expire(Time timeout)
+  {
+    Time now = Simulator::Now();
+    std::vector<Key> expired;
+
+    while (!m_queue.empty()) {
+      const Entry& entry = m_queue.front();
+      auto pending = m_pending.find(entry.key);
+      if (pending == m_pending.end() || pending->second != entry.time) {
+        m_queue.pop_front(); // removed or re-sent
+        continue;
+      }
+
+      if (entry.time + timeout > now)
+        break; // all later Interests were sent after this one
+
+      expired.push_back(entry.key);
+      m_pending.erase(pending);
+      m_queue.pop_front();
+    }
+
+    if (!expired.empty() && m_callback) {
+      m_callback(expired);
+    }
+    return expired.size();
+  }
+
+  /**
+   * @brief Forget all outstanding Interests and cancel the expiration event
+   */
+  void
+  Cancel()
+  {
+    m_pending.clear();
+    m_queue.clear();
+    if (m_event.IsRunning()) {
+      Simulator::Remove(m_event);
+    }
+  }
+
+private:
+  void
+  Arm()
+  {
+    if (m_timeout.IsZero() || m_queue.empty() || m_event.IsRunning())
+      return;
+
+    Time delay = m_queue.front().time + m_timeout - Simulator::Now();
+    m_event = Simulator::Schedule(Max(delay, Seconds(0)), &RetxTimer::OnTimer, this);
+  }
+
+  void
+  OnTimer()
+  {
+    Expire(m_timeout);
+    Arm();
+  }
+
+private:
+  struct Entry {
+    Time time;
+    Key key;
+  };
+
+  std::deque<Entry> m_queue;
+  std::unordered_map<Key, Time, Hash> m_pending;
+
+  Time m_timeout;
+  EventId m_event;
+  ExpireCallback m_callback;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_RETX_TIMER_H
@@ -0,0 +1,121 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "ndn-zipf-distribution.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <map>
+
+#include <boost/tuple/tuple.hpp>
+#include <boost/tuple/tuple_comparison.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+std::shared_ptr<const ZipfDistribution>
+ZipfDistribution::Get(uint32_t n, double q, double s)
+{
+  typedef boost::tuple<uint32_t, double, double> Key;
+  static std::map<Key, std::weak_ptr<const ZipfDistribution>> registry;
+
+  std::weak_ptr<const ZipfDistribution>& entry = registry[Key(n, q, s)];
+  std::shared_ptr<const ZipfDistribution> distribution = entry.lock();
+  if (distribution == nullptr) {
+    distribution = std::make_shared<ZipfDistribution>(n, q, s);
+    entry = distribution;
+  }
+  return distribution;
+}
+
+ZipfDistribution::ZipfDistribution(uint32_t n, double q, double s)
+  : m_n(n)
+  , m_q(q)
+  , m_s(s)
+  , m_normalizer(0)
+  , m_pmf(n + 1, 0.0)
+  , m_pcum(n + 1, 0.0)
+{
+  for (uint32_t k = 1; k <= m_n; k++) {
+    m_pmf[k] = std::pow(k + m_q, -m_s);
+    m_normalizer += m_pmf[k];
+  }
+
+  for (uint32_t k = 1; k <= m_n; k++) {
+    m_pmf[k] /= m_normalizer;
+    m_pcum[k] = m_pcum[k - 1] + m_pmf[k];
+  }
+}
+
+uint32_t
+ZipfDistribution::GetN() const
+{
+  return m_n;
+}
+
+double
+ZipfDistribution::GetQ() const
+{
+  return m_q;
+}
+
+double
+ZipfDistribution::GetS() const
+{
+  return m_s;
+}
+
+double
+ZipfDistribution::GetNormalizer() const
+{
+  return m_normalizer;
+}
+
+double
+ZipfDistribution::GetProbability(uint32_t rank) const
+{
+  if (rank >= 1 && rank <= m_n)
+    return m_pmf[rank];
+
+  return std::pow(rank + m_q, -m_s) / m_normalizer;
+}
+
+double
+ZipfDistribution::GetCumulativeProbability(uint32_t rank) const
+{
+  return m_pcum[std::min(rank, m_n)];
+}
+
+uint32_t
+ZipfDistribution::GetRank(double u) const
+{
+  if (m_n == 0)
+    return 0;
+
+  // first rank whose cumulative probability reaches u; rounding may leave m_pcum[N]
+  // slightly below 1, so anything past the end maps to the last rank
+  std::vector<double>::const_iterator it = std::lower_bound(m_pcum.begin() + 1, m_pcum.end(), u);
+  if (it == m_pcum.end())
+    return m_n;
+
+  return static_cast<uint32_t>(it - m_pcum.begin());
+}
+
+} // namespace ndn
+} // namespace ns3
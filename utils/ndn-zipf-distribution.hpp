@@ -0,0 +1,104 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef NDN_ZIPF_DISTRIBUTION_H
+#define NDN_ZIPF_DISTRIBUTION_H
+
+#include <memory>
+
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-helpers
+ * @brief Precomputed Zipf-Mandelbrot popularity distribution over ranks [1, N]
+ *
+ * The probability of rank k is (k + q)^-s / H, where H is the sum over all ranks. Both the
+ * probability mass and the cumulative distribution are tabulated once, so probability lookups
+ * are O(1) and inverse-CDF sampling is a binary search, O(log N).
+ *
+ * Distributions are immutable and shared: all users that ask for the same (N, q, s) through
+ * ZipfDistribution::Get receive the same instance.
+ */
+class ZipfDistribution {
+public:
+  /**
+   * @brief Get the shared distribution for the given parameters, building it if needed
+   *
+   * The instance is kept alive for as long as any user holds a reference to it.
+   */
+  static std::shared_ptr<const ZipfDistribution>
+  Get(uint32_t n, double q, double s);
+
+  ZipfDistribution(uint32_t n, double q, double s);
+
+  uint32_t
+  GetN() const;
+
+  double
+  GetQ() const;
+
+  double
+  GetS() const;
+
+  /**
+   * @brief Get the normalization constant H = sum (k + q)^-s, k = 1..N
+   */
+  double
+  GetNormalizer() const;
+
+  /**
+   * @brief Get the probability of the given rank
+   *
+   * Ranks in [1, N] are looked up in the table, any other rank is evaluated with the same
+   * formula.
+   */
+  double
+  GetProbability(uint32_t rank) const;
+
+  /**
+   * @brief Get the cumulative probability of ranks [1, rank]
+   */
+  double
+  GetCumulativeProbability(uint32_t rank) const;
+
+  /**
+   * @brief Map a uniform value in (0, 1] to a rank in [1, N]
+   *
+   * Returns the smallest rank whose cumulative probability is not less than @p u.
+   */
+  uint32_t
+  GetRank(double u) const;
+
+private:
+  uint32_t m_n;
+  double m_q;
+  double m_s;
+  double m_normalizer;
+
+  std::vector<double> m_pmf;  // m_pmf[k] = p(k), m_pmf[0] = 0
+  std::vector<double> m_pcum; // m_pcum[k] = p(1) + ... + p(k), m_pcum[0] = 0
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // NDN_ZIPF_DISTRIBUTION_H
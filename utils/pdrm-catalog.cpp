@@ -29,7 +29,9 @@ namespace ndn {
 using ::ndn::Name;
 
 PDRMCatalog::PDRMCatalog()
-  : m_rand(CreateObject<UniformRandomVariable>())
+  : m_objectCount(0)
+  , m_popularityRand(CreateObject<UniformRandomVariable>())
+  , m_rand(CreateObject<UniformRandomVariable>())
 {
   m_domains = 1;
   m_locality = 0;
@@ -52,23 +54,16 @@ PDRMCatalog::initializeLocalityCatalog(uint32_t size, double alpha)
 {
   uint32_t domainCatalogSize = size / m_domains;
 
-  m_popularityDistribution = CreateObject<ZipfRandomVariable>();
-  m_popularityDistribution->SetAttribute("N", IntegerValue(domainCatalogSize));
-  m_popularityDistribution->SetAttribute("Alpha", DoubleValue(alpha));
+  m_popularityDistribution = ZipfDistribution::Get(domainCatalogSize, 0, alpha);
 
   m_catalogSize = size;
-  m_alpha = alpha;
-
-  m_totalProbability = 0;
-  for (uint32_t i = 1; i <= domainCatalogSize; i++) {
-    m_totalProbability += pow(i, -1*alpha);
-  }
+  resetCatalog(size);
 }
 
-ContentObject
+const ContentObject&
 PDRMCatalog::getLocalityObjectRequest(uint32_t domain)
 {
-  uint32_t objectIndex = m_popularityDistribution->GetInteger() - 1;
+  uint32_t objectIndex = getPopularityRank() - 1;
 
   // scale
   objectIndex *= m_domains;
@@ -81,11 +76,11 @@ PDRMCatalog::getLocalityObjectRequest(uint32_t domain)
     objectIndex += (m_domains-1); // global content
   }
 
-  return m_catalog[objectIndex];
+  return getObject(objectIndex);
 }
 
 double
-PDRMCatalog::getLocalityRequestProbability(Name object, uint32_t domain)
+PDRMCatalog::getLocalityRequestProbability(const Name& object, uint32_t domain) const
 {
   uint32_t objectIndex = getObjectPopularity(object) % m_domains;
 
@@ -95,7 +90,7 @@ PDRMCatalog::getLocalityRequestProbability(Name object, uint32_t domain)
   else if (objectIndex == m_domains - 1)
     locality = 1 - m_locality;
 
-  return (pow(objectIndex, -1*m_alpha) / m_totalProbability) * 20 * locality;
+  return m_popularityDistribution->GetProbability(objectIndex) * 20 * locality;
 }
 
 // default
@@ -106,7 +101,7 @@ PDRMCatalog::setObjectSize(uint32_t objectSize)
 }
 
 uint32_t
-PDRMCatalog::getCatalogSize()
+PDRMCatalog::getCatalogSize() const
 {
   return m_catalogSize;
 }
@@ -114,64 +109,98 @@ PDRMCatalog::getCatalogSize()
 void
 PDRMCatalog::initializeCatalog(uint32_t size, double alpha)
 {
-  m_popularityDistribution = CreateObject<ZipfRandomVariable>();
-  m_popularityDistribution->SetAttribute("N", IntegerValue(size));
-  m_popularityDistribution->SetAttribute("Alpha", DoubleValue(alpha));
+  m_popularityDistribution = ZipfDistribution::Get(size, 0, alpha);
 
   m_catalogSize = size;
-  m_alpha = alpha;
+  resetCatalog(size);
+}
 
-  m_totalProbability = 0;
-  for (uint32_t i = 1; i <= size; i++) {
-    m_totalProbability += pow(i, -1*alpha);
-  }
+void
+PDRMCatalog::resetCatalog(uint32_t size)
+{
+  // Slots are created by addObject as objects are added: a catalog of N objects is described
+  // by the popularity distribution alone, and empty slots would cost a Name each
+  m_catalog.clear();
+  m_catalog.shrink_to_fit();
+  m_ids.clear();
+  m_ids.reserve(size);
+  m_objectCount = 0;
 }
 
 void
-PDRMCatalog::addObject(Name object, uint32_t index)
+PDRMCatalog::addObject(const Name& object, uint32_t index)
 {
-  ContentObject producedObject;
+  if (index >= m_catalog.size())
+    m_catalog.resize(index + 1);
+
+  ContentObject& producedObject = m_catalog[index];
+  if (producedObject.name.empty())
+    m_objectCount++;
+
   producedObject.name = object;
   producedObject.size = m_objectSize;
   producedObject.availability = m_rand->GetValue(0, 1);
   producedObject.locality = index % m_domains;
 
-  m_catalog[index] = producedObject;
-  m_popularity[object] = index;
+  m_ids[object] = index;
 }
 
 void
-PDRMCatalog::addObject(Name object)
+PDRMCatalog::addObject(const Name& object)
 {
-  uint32_t objectIndex = m_rand->GetValue(0, m_catalog.size());
+  uint32_t objectIndex = m_rand->GetValue(0, m_objectCount);
   addObject(object, objectIndex);
 }
 
-ContentObject
-PDRMCatalog::getObject(Name object)
+const ContentObject&
+PDRMCatalog::getObject(const Name& object) const
 {
-  uint32_t objectIndex = getObjectPopularity(object);
-  return m_catalog[objectIndex];
+  return getObject(getObjectPopularity(object));
+}
+
+const ContentObject&
+PDRMCatalog::getObject(uint32_t index) const
+{
+  static const ContentObject EMPTY = ContentObject();
+
+  if (index >= m_catalog.size())
+    return EMPTY;
+
+  return m_catalog[index];
 }
 
-ContentObject
+const ContentObject&
 PDRMCatalog::getObjectRequest()
 {
-  uint32_t objectIndex = m_popularityDistribution->GetInteger() - 1;
-  return m_catalog[objectIndex];
+  uint32_t objectIndex = getPopularityRank() - 1;
+  return getObject(objectIndex);
 }
 
 uint32_t
-PDRMCatalog::getObjectPopularity(Name object)
+PDRMCatalog::getObjectPopularity(const Name& object) const
 {
-  return m_popularity[object];
+  unordered_map<Name, uint32_t, NameHash>::const_iterator it = m_ids.find(object);
+  if (it == m_ids.end())
+    return 0;
+
+  return it->second;
 }
 
 double
-PDRMCatalog::getRequestProbability(Name object)
+PDRMCatalog::getRequestProbability(const Name& object) const
 {
   uint32_t objectIndex = getObjectPopularity(object);
-  return (pow(objectIndex, -1*m_alpha) / m_totalProbability)*20;
+  return m_popularityDistribution->GetProbability(objectIndex) * 20;
+}
+
+uint32_t
+PDRMCatalog::getPopularityRank()
+{
+  double u = m_popularityRand->GetValue(0, 1);
+  while (u == 0) {
+    u = m_popularityRand->GetValue(0, 1);
+  }
+  return m_popularityDistribution->GetRank(u);
 }
 
 } // namespace ndn
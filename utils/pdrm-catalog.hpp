@@ -28,6 +28,12 @@
 
 #include "ns3/random-variable-stream.h"
 
+#include "ndn-name-hash.hpp"
+#include "ndn-zipf-distribution.hpp"
+
+#include <unordered_map>
+#include <vector>
+
 using namespace std;
 
 namespace ns3 {
@@ -42,6 +48,15 @@ struct ContentObject {
   uint32_t locality;
 };
 
+/**
+ * @brief Catalog of the objects produced in a PDRM scenario
+ *
+ * Objects are interned: they are stored in a dense vector indexed by their popularity index,
+ * and a hash index maps object names to that index. Accessors return const references into the
+ * catalog, so lookups neither copy nor allocate. The vector only grows as objects are added, so
+ * indexes past the last added object yield an empty object. The references stay valid until the
+ * catalog is re-initialized or an object is added past the last added index.
+ */
 class PDRMCatalog : public Object
 {
 public:
@@ -55,53 +70,71 @@ public:
   void
   initializeLocalityCatalog(uint32_t size, double alpha);
 
-  ContentObject
+  const ContentObject&
   getLocalityObjectRequest(uint32_t domain);
 
   double
-  getLocalityRequestProbability(Name object, uint32_t domain);
+  getLocalityRequestProbability(const Name& object, uint32_t domain) const;
 
   // default
   void
   setObjectSize(uint32_t objectSize);
 
   uint32_t
-  getCatalogSize();
+  getCatalogSize() const;
 
   void
   initializeCatalog(uint32_t size, double alpha);
 
   void
-  addObject(Name object, uint32_t index);
+  addObject(const Name& object, uint32_t index);
 
   void
-  addObject(Name object);
+  addObject(const Name& object);
+
+  const ContentObject&
+  getObject(const Name& object) const;
 
-  ContentObject
-  getObject(Name object);
+  /**
+   * @brief Get the object with the given popularity index
+   */
+  const ContentObject&
+  getObject(uint32_t index) const;
 
-  ContentObject
+  const ContentObject&
   getObjectRequest();
 
+  /**
+   * @brief Get the popularity index of the object, 0 if the object is unknown
+   */
   uint32_t
-  getObjectPopularity(Name object);
+  getObjectPopularity(const Name& object) const;
 
   double
-  getRequestProbability(Name object);
+  getRequestProbability(const Name& object) const;
 
 private:
-  map<uint32_t, ContentObject> m_catalog;
-  map<Name, uint32_t> m_popularity;
+  void
+  resetCatalog(uint32_t size);
 
-  Ptr<ZipfRandomVariable> m_popularityDistribution;
+  /**
+   * @brief Draw a popularity rank in [1, N] from the shared Zipf distribution
+   */
+  uint32_t
+  getPopularityRank();
+
+private:
+  vector<ContentObject> m_catalog;               ///< @brief objects, indexed by popularity
+  unordered_map<Name, uint32_t, NameHash> m_ids; ///< @brief object name -> popularity index
+  uint32_t m_objectCount;                        ///< @brief number of occupied catalog slots
+
+  std::shared_ptr<const ZipfDistribution> m_popularityDistribution;
+  Ptr<UniformRandomVariable> m_popularityRand;
   Ptr<UniformRandomVariable> m_rand;
 
   uint32_t m_objectSize;
   uint32_t m_catalogSize;
 
-  double m_totalProbability;
-  double m_alpha;
-
   // locality
   uint32_t m_domains;
   double m_locality;
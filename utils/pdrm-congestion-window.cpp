@@ -0,0 +1,307 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "pdrm-congestion-window.hpp"
+
+#include "ns3/simulator.h"
+#include "ns3/double.h"
+#include "ns3/uinteger.h"
+#include "ns3/log.h"
+
+#include <cmath>
+#include <limits>
+
+NS_LOG_COMPONENT_DEFINE("ndn.PDRMCongestionWindow");
+
+namespace ns3 {
+namespace ndn {
+
+NS_OBJECT_ENSURE_REGISTERED(PDRMCongestionWindow);
+NS_OBJECT_ENSURE_REGISTERED(PDRMFixedWindow);
+NS_OBJECT_ENSURE_REGISTERED(PDRMAimdWindow);
+NS_OBJECT_ENSURE_REGISTERED(PDRMCubicWindow);
+
+TypeId
+PDRMCongestionWindow::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PDRMCongestionWindow")
+      .SetGroupName("Ndn")
+      .SetParent<Object>()
+
+      .AddAttribute("MinWindow",
+                    "Minimum size of the window",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&PDRMCongestionWindow::m_minWindow),
+                    MakeDoubleChecker<double>(1.0));
+
+  return tid;
+}
+
+PDRMCongestionWindow::PDRMCongestionWindow()
+  : m_window(1.0)
+  , m_minWindow(1.0)
+  , m_lastDecrease(Seconds(-1))
+{
+}
+
+uint32_t
+PDRMCongestionWindow::GetWindow() const
+{
+  if (m_window >= std::numeric_limits<uint32_t>::max())
+    return std::numeric_limits<uint32_t>::max();
+
+  return static_cast<uint32_t>(m_window);
+}
+
+bool
+PDRMCongestionWindow::IsInRecovery(Time rtt) const
+{
+  return m_lastDecrease >= Seconds(0) && Simulator::Now() - m_lastDecrease < rtt;
+}
+
+// Fixed
+
+TypeId
+PDRMFixedWindow::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PDRMFixedWindow")
+      .SetGroupName("Ndn")
+      .SetParent<PDRMCongestionWindow>()
+      .AddConstructor<PDRMFixedWindow>()
+
+      .AddAttribute("Window",
+                    "Number of Interests allowed in flight (unlimited by default)",
+                    UintegerValue(std::numeric_limits<uint32_t>::max()),
+                    MakeUintegerAccessor(&PDRMFixedWindow::SetWindow,
+                                         &PDRMFixedWindow::GetFixedWindow),
+                    MakeUintegerChecker<uint32_t>(1));
+
+  return tid;
+}
+
+void
+PDRMFixedWindow::SetWindow(uint32_t window)
+{
+  m_window = window;
+}
+
+uint32_t
+PDRMFixedWindow::GetFixedWindow() const
+{
+  return GetWindow();
+}
+
+void
+PDRMFixedWindow::OnData(Time)
+{
+}
+
+void
+PDRMFixedWindow::OnTimeout(Time)
+{
+}
+
+// AIMD
+
+TypeId
+PDRMAimdWindow::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PDRMAimdWindow")
+      .SetGroupName("Ndn")
+      .SetParent<PDRMCongestionWindow>()
+      .AddConstructor<PDRMAimdWindow>()
+
+      .AddAttribute("InitialWindow",
+                    "Initial size of the window",
+                    UintegerValue(1),
+                    MakeUintegerAccessor(&PDRMAimdWindow::SetInitialWindow,
+                                         &PDRMAimdWindow::GetInitialWindow),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("SlowStartThreshold",
+                    "Initial slow start threshold",
+                    DoubleValue(std::numeric_limits<double>::max()),
+                    MakeDoubleAccessor(&PDRMAimdWindow::m_slowStartThreshold),
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("AdditiveIncrease",
+                    "Increase of the window per RTT in congestion avoidance",
+                    DoubleValue(1.0),
+                    MakeDoubleAccessor(&PDRMAimdWindow::m_additiveIncrease),
+                    MakeDoubleChecker<double>(0.0))
+
+      .AddAttribute("MultiplicativeDecrease",
+                    "Factor applied to the window on timeout",
+                    DoubleValue(0.5),
+                    MakeDoubleAccessor(&PDRMAimdWindow::m_multiplicativeDecrease),
+                    MakeDoubleChecker<double>(0.0, 1.0));
+
+  return tid;
+}
+
+PDRMAimdWindow::PDRMAimdWindow()
+  : m_slowStartThreshold(std::numeric_limits<double>::max())
+  , m_additiveIncrease(1.0)
+  , m_multiplicativeDecrease(0.5)
+{
+}
+
+void
+PDRMAimdWindow::SetInitialWindow(uint32_t window)
+{
+  m_window = window;
+}
+
+uint32_t
+PDRMAimdWindow::GetInitialWindow() const
+{
+  return GetWindow();
+}
+
+void
+PDRMAimdWindow::OnData(Time)
+{
+  if (m_window < m_slowStartThreshold)
+    m_window += 1.0;
+  else
+    m_window += m_additiveIncrease / m_window;
+}
+
+void
+PDRMAimdWindow::OnTimeout(Time rtt)
+{
+  if (IsInRecovery(rtt))
+    return;
+
+  m_slowStartThreshold = std::max(m_window * m_multiplicativeDecrease, m_minWindow);
+  m_window = m_slowStartThreshold;
+  m_lastDecrease = Simulator::Now();
+  NS_LOG_DEBUG("Window: " << m_window);
+}
+
+// CUBIC
+
+TypeId
+PDRMCubicWindow::GetTypeId()
+{
+  static TypeId tid =
+    TypeId("ns3::ndn::PDRMCubicWindow")
+      .SetGroupName("Ndn")
+      .SetParent<PDRMCongestionWindow>()
+      .AddConstructor<PDRMCubicWindow>()
+
+      .AddAttribute("InitialWindow",
+                    "Initial size of the window",
+                    UintegerValue(1),
+                    MakeUintegerAccessor(&PDRMCubicWindow::SetInitialWindow,
+                                         &PDRMCubicWindow::GetInitialWindow),
+                    MakeUintegerChecker<uint32_t>(1))
+
+      .AddAttribute("SlowStartThreshold",
+                    "Initial slow start threshold",
+                    DoubleValue(std::numeric_limits<double>::max()),
+                    MakeDoubleAccessor(&PDRMCubicWindow::m_slowStartThreshold),
+                    MakeDoubleChecker<double>())
+
+      .AddAttribute("C",
+                    "Scaling constant of the cubic function",
+                    DoubleValue(0.4),
+                    MakeDoubleAccessor(&PDRMCubicWindow::m_c),
+                    MakeDoubleChecker<double>(0.0))
+
+      .AddAttribute("Beta",
+                    "Factor applied to the window on timeout",
+                    DoubleValue(0.7),
+                    MakeDoubleAccessor(&PDRMCubicWindow::m_beta),
+                    MakeDoubleChecker<double>(0.0, 1.0));
+
+  return tid;
+}
+
+PDRMCubicWindow::PDRMCubicWindow()
+  : m_slowStartThreshold(std::numeric_limits<double>::max())
+  , m_c(0.4)
+  , m_beta(0.7)
+  , m_lastMaxWindow(0.0)
+  , m_k(0.0)
+  , m_inEpoch(false)
+{
+}
+
+void
+PDRMCubicWindow::SetInitialWindow(uint32_t window)
+{
+  m_window = window;
+}
+
+uint32_t
+PDRMCubicWindow::GetInitialWindow() const
+{
+  return GetWindow();
+}
+
+void
+PDRMCubicWindow::OnData(Time rtt)
+{
+  if (m_window < m_slowStartThreshold) {
+    m_window += 1.0;
+    return;
+  }
+
+  if (!m_inEpoch) {
+    m_inEpoch = true;
+    m_epochStart = Simulator::Now();
+    if (m_window < m_lastMaxWindow) {
+      m_k = std::cbrt((m_lastMaxWindow - m_window) / m_c);
+    }
+    else {
+      m_k = 0.0;
+      m_lastMaxWindow = m_window;
+    }
+  }
+
+  // window the cubic function targets one RTT from now
+  double t = (Simulator::Now() + rtt - m_epochStart).GetSeconds();
+  double target = m_lastMaxWindow + m_c * std::pow(t - m_k, 3);
+
+  if (target > m_window)
+    m_window += (target - m_window) / m_window;
+  else
+    m_window += 0.01 / m_window;
+}
+
+void
+PDRMCubicWindow::OnTimeout(Time rtt)
+{
+  if (IsInRecovery(rtt))
+    return;
+
+  m_lastMaxWindow = m_window;
+  m_window = std::max(m_window * m_beta, m_minWindow);
+  m_slowStartThreshold = m_window;
+  m_inEpoch = false;
+  m_lastDecrease = Simulator::Now();
+  NS_LOG_DEBUG("Window: " << m_window);
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,170 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef PDRM_CONGESTION_WINDOW_H
+#define PDRM_CONGESTION_WINDOW_H
+
+#include "ns3/object.h"
+#include "ns3/nstime.h"
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Base class for the congestion window of PDRM consumers
+ *
+ * The window limits the number of Interests a consumer keeps in flight.  It is updated on each
+ * retrieved chunk and on each Interest timeout, using the smoothed RTT of the consumer.
+ */
+class PDRMCongestionWindow : public Object {
+public:
+  static TypeId
+  GetTypeId();
+
+  PDRMCongestionWindow();
+
+  /**
+   * @brief Number of Interests allowed in flight
+   */
+  uint32_t
+  GetWindow() const;
+
+  /**
+   * @brief Chunk retrieved
+   * @param rtt current RTT estimate
+   */
+  virtual void
+  OnData(Time rtt) = 0;
+
+  /**
+   * @brief Interest timed out
+   * @param rtt current RTT estimate
+   */
+  virtual void
+  OnTimeout(Time rtt) = 0;
+
+protected:
+  /**
+   * @brief Check whether the window has already been reduced during the last RTT
+   *
+   * Interests sent in the same window usually time out together; only the first timeout
+   * should reduce the window.
+   */
+  bool
+  IsInRecovery(Time rtt) const;
+
+protected:
+  double m_window;
+  double m_minWindow;
+  Time m_lastDecrease;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Fixed congestion window (no congestion control)
+ */
+class PDRMFixedWindow : public PDRMCongestionWindow {
+public:
+  static TypeId
+  GetTypeId();
+
+  virtual void
+  OnData(Time rtt);
+
+  virtual void
+  OnTimeout(Time rtt);
+
+private:
+  void
+  SetWindow(uint32_t window);
+
+  uint32_t
+  GetFixedWindow() const;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief Additive-increase/multiplicative-decrease window with slow start
+ */
+class PDRMAimdWindow : public PDRMCongestionWindow {
+public:
+  static TypeId
+  GetTypeId();
+
+  PDRMAimdWindow();
+
+  virtual void
+  OnData(Time rtt);
+
+  virtual void
+  OnTimeout(Time rtt);
+
+private:
+  void
+  SetInitialWindow(uint32_t window);
+
+  uint32_t
+  GetInitialWindow() const;
+
+private:
+  double m_slowStartThreshold;
+  double m_additiveIncrease;
+  double m_multiplicativeDecrease;
+};
+
+/**
+ * @ingroup ndn-apps
+ * @brief CUBIC-like window: grows as a cubic function of the time since the last reduction
+ */
+class PDRMCubicWindow : public PDRMCongestionWindow {
+public:
+  static TypeId
+  GetTypeId();
+
+  PDRMCubicWindow();
+
+  virtual void
+  OnData(Time rtt);
+
+  virtual void
+  OnTimeout(Time rtt);
+
+private:
+  void
+  SetInitialWindow(uint32_t window);
+
+  uint32_t
+  GetInitialWindow() const;
+
+private:
+  double m_slowStartThreshold;
+  double m_c;
+  double m_beta;
+
+  double m_lastMaxWindow; ///< @brief window before the last reduction
+  double m_k;             ///< @brief time (seconds) to grow back to m_lastMaxWindow
+  Time m_epochStart;
+  bool m_inEpoch;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // PDRM_CONGESTION_WINDOW_H
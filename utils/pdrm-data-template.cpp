@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "pdrm-data-template.hpp"
+
+#include <ndn-cxx/encoding/encoding-buffer.hpp>
+#include <ndn-cxx/encoding/tlv.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+PDRMDataTemplate::PDRMDataTemplate()
+  : PDRMDataTemplate(0, Seconds(0), 0, Name())
+{
+}
+
+PDRMDataTemplate::PDRMDataTemplate(uint32_t payloadSize, Time freshness, uint32_t signature,
+                                   const Name& keyLocator, bool unsolicited)
+{
+  SignatureInfo signatureInfo(static_cast< ::ndn::tlv::SignatureTypeValue>(255));
+
+  if (keyLocator.size() > 0) {
+    signatureInfo.setKeyLocator(keyLocator);
+  }
+
+  m_signature.setInfo(signatureInfo);
+  m_signature.setValue(::ndn::nonNegativeIntegerBlock(::ndn::tlv::SignatureValue, signature));
+
+  Data prototype;
+  prototype.setFreshnessPeriod(::ndn::time::milliseconds(freshness.GetMilliSeconds()));
+  prototype.setContent(make_shared< ::ndn::Buffer>(payloadSize));
+  prototype.setSignature(m_signature);
+  if (unsolicited) {
+    prototype.setUnsolicited(true);
+  }
+
+  // Everything after the Name TLV is the same for all packets created from the template
+  Block wire = prototype.wireEncode();
+  wire.parse();
+  const Block& name = wire.get(::ndn::tlv::Name);
+  m_suffix = make_shared< ::ndn::Buffer>(name.end(), wire.end());
+}
+
+shared_ptr<Data>
+PDRMDataTemplate::create(const Name& name) const
+{
+  const Block& nameWire = name.wireEncode();
+  size_t length = nameWire.size() + m_suffix->size();
+
+  ::ndn::EncodingBuffer encoder(length + 2 * 9, 0);
+  encoder.prependByteArray(m_suffix->buf(), m_suffix->size());
+  encoder.prependByteArray(nameWire.wire(), nameWire.size());
+  encoder.prependVarNumber(length);
+  encoder.prependVarNumber(::ndn::tlv::Data);
+
+  auto data = make_shared<Data>();
+  data->wireDecode(encoder.block());
+  return data;
+}
+
+shared_ptr<Data>
+PDRMDataTemplate::create(const Name& prefix, uint64_t seq) const
+{
+  Name name(prefix);
+  name.appendSequenceNumber(seq);
+  return create(name);
+}
+
+const Signature&
+PDRMDataTemplate::getSignature() const
+{
+  return m_signature;
+}
+
+} // namespace ndn
+} // namespace ns3
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef PDRM_DATA_TEMPLATE_H
+#define PDRM_DATA_TEMPLATE_H
+
+#include "ns3/ndnSIM/model/ndn-common.hpp"
+
+#include <ndn-cxx/encoding/buffer.hpp>
+
+namespace ns3 {
+namespace ndn {
+
+/**
+ * @ingroup ndn-apps
+ * @brief Reusable template for Data packets produced by PDRM apps
+ *
+ * Virtual payload, MetaInfo, and fake signature are the same for every chunk served by an
+ * app.  They are encoded once; creating a Data packet then only encodes its name and copies
+ * the pre-encoded remainder of the packet.
+ */
+class PDRMDataTemplate {
+public:
+  PDRMDataTemplate();
+
+  /**
+   * @param payloadSize Virtual payload size (zero-filled content)
+   * @param freshness   Freshness period, if 0, then unlimited freshness
+   * @param signature   Fake signature value
+   * @param keyLocator  Name to be used for key locator, not used if empty
+   * @param unsolicited Mark created Data packets as unsolicited (pushed by the producer)
+   */
+  PDRMDataTemplate(uint32_t payloadSize, Time freshness, uint32_t signature,
+                   const Name& keyLocator, bool unsolicited = false);
+
+  /**
+   * @brief Create wire-encoded Data packet with the given name
+   */
+  shared_ptr<Data>
+  create(const Name& name) const;
+
+  /**
+   * @brief Create wire-encoded Data packet for chunk @p seq of object @p prefix
+   */
+  shared_ptr<Data>
+  create(const Name& prefix, uint64_t seq) const;
+
+  /**
+   * @brief Get fake signature, e.g., for Data packets with non-constant content
+   */
+  const Signature&
+  getSignature() const;
+
+private:
+  Signature m_signature;
+  shared_ptr<const ::ndn::Buffer> m_suffix; ///< @brief encoded MetaInfo, Content, and signature
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // PDRM_DATA_TEMPLATE_H
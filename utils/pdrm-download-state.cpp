@@ -0,0 +1,160 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#include "pdrm-download-state.hpp"
+
+#include "ns3/simulator.h"
+
+#include <algorithm>
+#include <limits>
+
+namespace ns3 {
+namespace ndn {
+
+const uint32_t PDRMDownloadState::INVALID_ID = std::numeric_limits<uint32_t>::max();
+
+PDRMDownloadState::PDRMDownloadState()
+  : m_pendingCount(0)
+{
+}
+
+uint32_t
+PDRMDownloadState::startObject(const Name& object, uint32_t size)
+{
+  uint32_t id;
+  if (m_freeIds.empty()) {
+    id = m_objects.size();
+    m_objects.push_back(Object());
+  }
+  else {
+    id = m_freeIds.back();
+    m_freeIds.pop_back();
+  }
+
+  Object& entry = m_objects[id];
+  entry.name = object;
+  entry.startTime = Simulator::Now();
+  entry.size = size;
+  entry.requests = 0;
+  entry.timeouts = 0;
+  entry.downloaded = 0;
+  entry.chunks.assign(size, Chunk());
+  entry.received.assign(size, false);
+
+  m_ids[object] = id;
+  return id;
+}
+
+void
+PDRMDownloadState::concludeObject(uint32_t id)
+{
+  Object& entry = m_objects[id];
+  for (uint32_t seqNumber = 0; seqNumber < entry.size; seqNumber++) {
+    if (isPending(id, seqNumber))
+      m_pendingCount--;
+  }
+
+  m_ids.erase(entry.name);
+  entry.chunks.clear();
+  entry.received.clear();
+  m_freeIds.push_back(id);
+}
+
+uint32_t
+PDRMDownloadState::getObjectId(const Name& object) const
+{
+  auto it = m_ids.find(object);
+  if (it == m_ids.end())
+    return INVALID_ID;
+
+  return it->second;
+}
+
+uint32_t
+PDRMDownloadState::getChunkId(const Name& chunk, uint32_t& seqNumber) const
+{
+  if (chunk.size() < 3)
+    return INVALID_ID;
+
+  uint32_t id = getObjectId(chunk.getPrefix(2));
+  if (id == INVALID_ID)
+    return INVALID_ID;
+
+  seqNumber = chunk.at(-1).toSequenceNumber();
+  if (seqNumber >= m_objects[id].size)
+    return INVALID_ID;
+
+  return id;
+}
+
+void
+PDRMDownloadState::recordRequest(uint32_t id, uint32_t seqNumber)
+{
+  Chunk& chunk = m_objects[id].chunks[seqNumber];
+  if (chunk.requestCount == 0) {
+    chunk.firstRequest = Simulator::Now();
+    if (!m_objects[id].received[seqNumber])
+      m_pendingCount++;
+  }
+
+  chunk.lastRequest = Simulator::Now();
+  chunk.requestCount++;
+}
+
+void
+PDRMDownloadState::clearChunk(uint32_t id, uint32_t seqNumber)
+{
+  if (isPending(id, seqNumber))
+    m_pendingCount--;
+
+  Chunk& chunk = m_objects[id].chunks[seqNumber];
+  chunk.firstRequest = Time();
+  chunk.lastRequest = Time();
+  chunk.requestCount = 0;
+}
+
+bool
+PDRMDownloadState::markReceived(uint32_t id, uint32_t seqNumber)
+{
+  clearChunk(id, seqNumber);
+
+  Object& entry = m_objects[id];
+  entry.received[seqNumber] = true;
+  entry.downloaded++;
+
+  return entry.downloaded == entry.size;
+}
+
+std::vector<uint32_t>
+PDRMDownloadState::getObjectIds() const
+{
+  std::vector<uint32_t> ids;
+  ids.reserve(m_ids.size());
+  for (const auto& entry : m_ids) {
+    ids.push_back(entry.second);
+  }
+
+  std::sort(ids.begin(), ids.end(), [this] (uint32_t lhs, uint32_t rhs) {
+      return m_objects[lhs].name < m_objects[rhs].name;
+    });
+  return ids;
+}
+
+} // namespace ndn
+} // namespace ns3
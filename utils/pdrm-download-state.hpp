@@ -0,0 +1,178 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef PDRM_DOWNLOAD_STATE_H
+#define PDRM_DOWNLOAD_STATE_H
+
+#include "ns3/nstime.h"
+
+#include <ndn-cxx/name.hpp>
+
+#include <utils/ndn-name-hash.hpp>
+
+#include <unordered_map>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+
+using ::ndn::Name;
+
+/**
+ * @brief Download state of the objects being retrieved by a PDRM consumer
+ *
+ * Each object in download is interned to a dense id.  Chunk records are kept in a contiguous
+ * array per object and indexed by the chunk sequence number, so that updating a chunk costs a
+ * single hash lookup of the object name.  Chunk names are expected to be /<object>/<seq>,
+ * where the object name has two components.
+ */
+class PDRMDownloadState
+{
+public:
+  struct Chunk {
+    Time firstRequest;
+    Time lastRequest;
+    uint32_t requestCount;
+  };
+
+  struct Object {
+    Name name;
+    Time startTime;
+    uint32_t size;
+    uint32_t requests;
+    uint32_t timeouts;
+    uint32_t downloaded;
+    std::vector<Chunk> chunks;
+    std::vector<bool> received; ///< @brief bitmap of retrieved chunks
+  };
+
+  static const uint32_t INVALID_ID;
+
+  PDRMDownloadState();
+
+  /**
+   * @brief Start tracking download of @p object with @p size chunks
+   * @returns id of the object
+   */
+  uint32_t
+  startObject(const Name& object, uint32_t size);
+
+  /**
+   * @brief Stop tracking @p id
+   */
+  void
+  concludeObject(uint32_t id);
+
+  /**
+   * @returns id of @p object, or INVALID_ID if it is not being downloaded
+   */
+  uint32_t
+  getObjectId(const Name& object) const;
+
+  /**
+   * @brief Get id of the object that @p chunk belongs to and its sequence number
+   * @returns INVALID_ID if the object is not being downloaded or the chunk is out of range
+   */
+  uint32_t
+  getChunkId(const Name& chunk, uint32_t& seqNumber) const;
+
+  bool
+  isDownloading(const Name& object) const
+  {
+    return getObjectId(object) != INVALID_ID;
+  }
+
+  Object&
+  getObject(uint32_t id)
+  {
+    return m_objects[id];
+  }
+
+  const Object&
+  getObject(uint32_t id) const
+  {
+    return m_objects[id];
+  }
+
+  Chunk&
+  getChunk(uint32_t id, uint32_t seqNumber)
+  {
+    return m_objects[id].chunks[seqNumber];
+  }
+
+  bool
+  isReceived(uint32_t id, uint32_t seqNumber) const
+  {
+    return m_objects[id].received[seqNumber];
+  }
+
+  /**
+   * @brief Check whether the chunk has been requested and not yet retrieved
+   */
+  bool
+  isPending(uint32_t id, uint32_t seqNumber) const
+  {
+    return m_objects[id].chunks[seqNumber].requestCount > 0 && !m_objects[id].received[seqNumber];
+  }
+
+  /**
+   * @brief Record a (re)transmission of the Interest for the chunk
+   */
+  void
+  recordRequest(uint32_t id, uint32_t seqNumber);
+
+  /**
+   * @brief Forget request history of the chunk
+   */
+  void
+  clearChunk(uint32_t id, uint32_t seqNumber);
+
+  /**
+   * @brief Mark the chunk as retrieved
+   * @returns true if all chunks of the object have been retrieved
+   */
+  bool
+  markReceived(uint32_t id, uint32_t seqNumber);
+
+  /**
+   * @brief Number of chunks requested and not yet retrieved, over all objects
+   */
+  uint32_t
+  getPendingCount() const
+  {
+    return m_pendingCount;
+  }
+
+  /**
+   * @brief Get ids of the objects in download, ordered by object name
+   */
+  std::vector<uint32_t>
+  getObjectIds() const;
+
+private:
+  std::vector<Object> m_objects;
+  std::vector<uint32_t> m_freeIds;
+  std::unordered_map<Name, uint32_t, NameHash> m_ids;
+  uint32_t m_pendingCount;
+};
+
+} // namespace ndn
+} // namespace ns3
+
+#endif // PDRM_DOWNLOAD_STATE_H
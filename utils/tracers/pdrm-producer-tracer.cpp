@@ -198,6 +198,9 @@ PDRMProducerTracer::Connect()
 
   Config::ConnectWithoutContext("/NodeList/" + m_node + "/ApplicationList/*/ProducedObject",
                                 MakeCallback(&PDRMProducerTracer::ProducedObject, this));
+
+  Config::ConnectWithoutContext("/NodeList/" + m_node + "/$ns3::ndn::GlobalRouter/AggregatedRoutes",
+                                MakeCallback(&PDRMProducerTracer::AggregatedRoutes, this));
 }
 
 void
@@ -206,6 +209,7 @@ PDRMProducerTracer::PrintHeader(std::ostream& os) const
   os << "ServedData\tTime\tNode\tAppId\tObject\n";
   os << "AnnouncedPrefix\tTime\tNode\tAppId\tPrefix\tIsAnnouncing\n";
   os << "ProducedObject\tTime\tNode\tAppId\tObject\tSize\tAvailability\tPopularity\n";
+  os << "AggregatedRoutes\tTime\tNode\tRoutes\tFibEntries\tSaved\n";
 }
 
 void
@@ -229,6 +233,13 @@ PDRMProducerTracer::ProducedObject(Ptr<App> app, Name object, uint32_t size, dou
         << app->GetId() << "\t" << object << "\t" << size << "\t" << availability << "\t" << popularity << "\n";
 }
 
+void
+PDRMProducerTracer::AggregatedRoutes(uint32_t routes, uint32_t fibEntries)
+{
+  *m_os << "AggregatedRoutes" << "\t" << Simulator::Now().ToDouble(Time::S) << "\t" << m_node << "\t"
+        << routes << "\t" << fibEntries << "\t" << static_cast<int64_t>(routes) - fibEntries << "\n";
+}
+
 
 } // namespace ndn
 } // namespace ns3
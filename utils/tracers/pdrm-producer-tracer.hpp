@@ -135,6 +135,9 @@ private:
   void
   ProducedObject(Ptr<App> app, Name object, uint32_t size, double availability, uint32_t popularity);
 
+  void
+  AggregatedRoutes(uint32_t routes, uint32_t fibEntries);
+
 private:
   std::string m_node;
   Ptr<Node> m_nodePtr;
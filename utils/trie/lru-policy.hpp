@@ -61,6 +61,7 @@ struct lru_policy_traits {
       type(Base& base)
         : base_(base)
         , max_size_(100)
+        , max_bytes_(0)
       {
       }
 
@@ -75,9 +76,15 @@ struct lru_policy_traits {
       inline bool
       insert(typename parent_trie::iterator item)
       {
-        if (max_size_ != 0 && policy_container::size() >= max_size_) {
+        /* PDRM Change */
+        size_t bytes = base_.get_payload_bytes(item);
+        if (max_bytes_ != 0 && bytes > max_bytes_)
+          return false; // would not fit even alone
+
+        while (!policy_container::empty() && is_full(bytes)) {
           base_.erase(&(*policy_container::begin()));
         }
+        /* PDRM Change */
 
         policy_container::push_back(*item);
         return true;
@@ -115,13 +122,42 @@ struct lru_policy_traits {
         return max_size_;
       }
 
+      /* PDRM Change */
+      /**
+       * @brief Set capacity in bytes taken by payloads (e.g., wire size of cached Data); 0 means
+       *        the capacity is not enforced
+       */
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+      /* PDRM Change */
+
     private:
       type()
         : base_(*((Base*)0)){};
 
+      /* PDRM Change */
+      // no room for a new payload of the given size without evicting
+      inline bool
+      is_full(size_t bytes) const
+      {
+        return (max_size_ != 0 && policy_container::size() >= max_size_)
+               || (max_bytes_ != 0 && base_.get_bytes() + bytes > max_bytes_);
+      }
+      /* PDRM Change */
+
     private:
       Base& base_;
       size_t max_size_;
+      size_t max_bytes_;
     };
   };
 };
@@ -153,6 +153,41 @@ struct multi_policy_traits {
         // as max size should be the same everywhere, get the value from the first available policy
         return policy_container::template get<0>().get_max_size();
       }
+
+      /* PDRM Change */
+      struct max_bytes_setter {
+        max_bytes_setter(policy_container& container, size_t bytes)
+          : m_container(container)
+          , m_bytes(bytes)
+        {
+        }
+
+        template<typename U>
+        void
+        operator()(U index)
+        {
+          m_container.template get<U::value>().set_max_bytes(m_bytes);
+        }
+
+      private:
+        policy_container& m_container;
+        size_t m_bytes;
+      };
+
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        boost::mpl::for_each<boost::mpl::range_c<int, 0,
+                                                 boost::mpl::size<policy_traits>::type::value>>(
+          max_bytes_setter(*this, max_bytes));
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return policy_container::template get<0>().get_max_bytes();
+      }
+      /* PDRM Change */
     };
   };
 
@@ -0,0 +1,985 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef RADIX_TRIE_H_
+#define RADIX_TRIE_H_
+
+/// @cond include_hidden
+
+#include "trie.hpp"
+#include "trie-with-policy.hpp"
+
+#include <algorithm>
+#include <memory>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+////////////////////////////////////////////////////
+// forward declarations
+//
+template<class T, class NonConstT>
+class radix_trie_iterator;
+
+template<class T>
+class radix_trie_point_iterator;
+
+/**
+ * @brief Path-compressed variant of trie
+ *
+ * A chain of nodes with a single child and without payload is collapsed into one node holding
+ * the span of their components, and children are kept in a small vector that becomes an open
+ * addressing hash table only for large child sets.  Names of PDRM chunks
+ * (/producer<P>/catalog/obj<O>/v<V>/<chunk>) thus take one node per chunk plus the few nodes
+ * where names diverge, instead of one node with its own hash set per component.
+ *
+ * Nodes with payload keep their identity while the trie is reshaped around them, so iterators
+ * to them stay valid the same way as in trie and the policy containers are unaffected.
+ */
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         typename Allocator = heap_allocator>
+class radix_trie : boost::noncopyable {
+public:
+  typedef typename FullKey::value_type Key;
+
+  typedef radix_trie* iterator;
+  typedef const radix_trie* const_iterator;
+
+  typedef radix_trie_iterator<radix_trie, radix_trie> recursive_iterator;
+  typedef radix_trie_iterator<const radix_trie, radix_trie> const_recursive_iterator;
+
+  typedef radix_trie_point_iterator<radix_trie> point_iterator;
+  typedef radix_trie_point_iterator<const radix_trie> const_point_iterator;
+
+  typedef PayloadTraits payload_traits;
+
+  typedef key_hashes<FullKey> key_hashes_type;
+  typedef Allocator allocator_type;
+
+  /**
+   * @brief Create the root of the trie
+   *
+   * Signature is the one of trie.  The root holds no components, so the key is not used, and
+   * child sets size themselves, so the bucket parameters are not used either.
+   */
+  inline radix_trie(const Key& key, allocator_type& allocator, size_t bucketSize = 1,
+                    size_t bucketIncrement = 1)
+    : radix_trie(allocator, 0)
+  {
+  }
+
+  inline ~radix_trie()
+  {
+    payload_ = PayloadTraits::empty_payload; // necessary for smart pointers...
+    children_.clear_and_dispose(*allocator_);
+    release_keys();
+  }
+
+  void
+  clear()
+  {
+    children_.clear_and_dispose(*allocator_);
+  }
+
+  template<class Predicate>
+  void
+  clear_if(Predicate cond)
+  {
+    recursive_iterator trieNode(this);
+    recursive_iterator end(0);
+
+    while (trieNode != end) {
+      if (cond(*trieNode)) {
+        trieNode = recursive_iterator(trieNode->erase());
+      }
+      trieNode++;
+    }
+  }
+
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, typename PayloadTraits::insert_type payload)
+  {
+    return insert(key, key_hashes_type(key), payload);
+  }
+
+  /**
+   * @brief Insert with the component hashes of the key already computed
+   */
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, const key_hashes_type& hashes,
+         typename PayloadTraits::insert_type payload)
+  {
+    radix_trie* trieNode = this;
+    typename FullKey::const_iterator subkey = key.begin();
+    size_t level = 0;
+
+    while (level < hashes.size()) {
+      radix_trie* child = trieNode->children_.find(*subkey, hashes[level]);
+      if (child == 0) {
+        // the rest of the key goes to a single new leaf
+        child = trieNode->new_child(subkey, hashes.size() - level, hashes[level]);
+        trieNode->children_.insert(child, *allocator_);
+        trieNode = child;
+        break;
+      }
+
+      size_t matched = child->match(subkey, level, hashes.size());
+      if (matched < child->keyCount_) {
+        trieNode = child->split(matched);
+      }
+      else {
+        trieNode = child;
+      }
+    }
+
+    if (trieNode->payload_ == PayloadTraits::empty_payload) {
+      trieNode->payload_ = payload;
+      return std::make_pair(trieNode, true);
+    }
+    else
+      return std::make_pair(trieNode, false);
+  }
+
+  /**
+   * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
+   */
+  inline iterator
+  erase()
+  {
+    payload_ = PayloadTraits::empty_payload;
+    return prune();
+  }
+
+  /**
+   * @brief Do exactly as erase, but without erasing the payload
+   *
+   * A node left with a single child is merged into it
+   */
+  inline iterator
+  prune()
+  {
+    if (payload_ != PayloadTraits::empty_payload || parent_ == 0)
+      return this;
+
+    radix_trie* parent = parent_;
+    if (children_.size() == 0) {
+      parent->children_.erase(this);
+      dispose(this); // delete this; basically, committing a suicide
+      return parent->prune();
+    }
+    else if (children_.size() == 1) {
+      merge_into_child();
+    }
+    return parent;
+  }
+
+  /**
+   * @brief Perform prune of the node, but without attempting to parent of the node
+   */
+  inline void
+  prune_node()
+  {
+    if (payload_ != PayloadTraits::empty_payload || parent_ == 0)
+      return;
+
+    if (children_.size() == 0) {
+      parent_->children_.erase(this);
+      dispose(this); // delete this; basically, committing a suicide
+    }
+    else if (children_.size() == 1) {
+      merge_into_child();
+    }
+  }
+
+  /**
+   * @brief Perform the longest prefix match
+   * @param key the key for which to perform the longest prefix match
+   *
+   * When the key ends inside the component span of a node, the node is returned as the last
+   * item with ->second set, as its sub-trie is the one of the key
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  inline std::tuple<iterator, bool, iterator>
+  find(const FullKey& key)
+  {
+    return find(key, key_hashes_type(key));
+  }
+
+  /**
+   * @brief Perform the longest prefix match, with the component hashes of the key already computed
+   */
+  inline std::tuple<iterator, bool, iterator>
+  find(const FullKey& key, const key_hashes_type& hashes)
+  {
+    return find_if(key, hashes, any_payload());
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying preficate
+   * @param key the key for which to perform the longest prefix match
+   *
+   * @return ->second is true if prefix in ->first is longer than key
+   */
+  template<class Predicate>
+  inline std::tuple<iterator, bool, iterator>
+  find_if(const FullKey& key, Predicate pred)
+  {
+    return find_if(key, key_hashes_type(key), pred);
+  }
+
+  /**
+   * @brief Perform the longest prefix match satisfying preficate, with the component hashes of the
+   *        key already computed
+   */
+  template<class Predicate>
+  inline std::tuple<iterator, bool, iterator>
+  find_if(const FullKey& key, const key_hashes_type& hashes, Predicate pred)
+  {
+    radix_trie* trieNode = this;
+    iterator foundNode = (payload_ != PayloadTraits::empty_payload && pred(payload_)) ? this : 0;
+    typename FullKey::const_iterator subkey = key.begin();
+    size_t level = 0;
+
+    while (level < hashes.size()) {
+      radix_trie* child = trieNode->children_.find(*subkey, hashes[level]);
+      if (child == 0)
+        return std::make_tuple(foundNode, false, trieNode);
+
+      size_t matched = child->match(subkey, level, hashes.size());
+      if (matched < child->keyCount_) {
+        // the key either ends inside the span (the sub-trie of the child is the one of the key)
+        // or diverges from it
+        if (level == hashes.size())
+          return std::make_tuple(foundNode, true, child);
+        else
+          return std::make_tuple(foundNode, false, trieNode);
+      }
+
+      trieNode = child;
+      if (trieNode->payload_ != PayloadTraits::empty_payload && pred(trieNode->payload_))
+        foundNode = trieNode;
+    }
+
+    return std::make_tuple(foundNode, true, trieNode);
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration
+   * )
+   */
+  inline iterator
+  find()
+  {
+    if (payload_ != PayloadTraits::empty_payload)
+      return this;
+
+    for (radix_trie* subnode = children_.first(); subnode != 0;
+         subnode = children_.next(subnode)) {
+      iterator value = subnode->find();
+      if (value != 0)
+        return value;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration
+   * )
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if(Predicate pred)
+  {
+    if (payload_ != PayloadTraits::empty_payload && pred(payload_))
+      return this;
+
+    for (radix_trie* subnode = children_.first(); subnode != 0;
+         subnode = children_.next(subnode)) {
+      iterator value = subnode->find_if(pred);
+      if (value != 0)
+        return value;
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Find next payload of the sub-trie satisfying the predicate
+   * @param pred predicate
+   *
+   * This version check predicate only for the next level children
+   *
+   * @returns end() or a valid iterator pointing to the trie leaf (order is not defined, enumeration
+   *)
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if_next_level(Predicate pred)
+  {
+    for (radix_trie* subnode = children_.first(); subnode != 0;
+         subnode = children_.next(subnode)) {
+      if (pred(subnode->key())) {
+        return subnode->find();
+      }
+    }
+
+    return 0;
+  }
+
+  /**
+   * @brief Same as find_if_next_level (pred), for the node returned by find for a key of @p level
+   *        components
+   *
+   * If the key ends inside the span of the node, the next level is the following component of
+   * the span
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if_next_level(Predicate pred, size_t level)
+  {
+    size_t depth = 0;
+    for (const radix_trie* node = parent_; node != 0; node = node->parent_) {
+      depth += node->keyCount_;
+    }
+
+    if (level < depth + keyCount_) {
+      return pred(keys_[level - depth]) ? find() : 0;
+    }
+    return find_if_next_level(pred);
+  }
+
+  iterator
+  end()
+  {
+    return 0;
+  }
+
+  const_iterator
+  end() const
+  {
+    return 0;
+  }
+
+  typename PayloadTraits::const_return_type
+  payload() const
+  {
+    return payload_;
+  }
+
+  typename PayloadTraits::return_type
+  payload()
+  {
+    return payload_;
+  }
+
+  void
+  set_payload(typename PayloadTraits::insert_type payload)
+  {
+    payload_ = payload;
+  }
+
+  /**
+   * @brief Get the first component of the span of the node (the component of trie node)
+   */
+  Key
+  key() const
+  {
+    return keyCount_ > 0 ? keys_[0] : Key();
+  }
+
+  /**
+   * @brief Get number of components in the span of the node
+   */
+  size_t
+  key_size() const
+  {
+    return keyCount_;
+  }
+
+  inline void
+  PrintStat(std::ostream& os) const;
+
+private:
+  struct any_payload {
+    template<class Payload>
+    bool
+    operator()(const Payload&) const
+    {
+      return true;
+    }
+  };
+
+  /**
+   * @brief Children of a node: a vector of pointers, inline while there are at most two, that
+   *        becomes an open addressing hash table (on hashes of the first components) past eight
+   */
+  class child_table : boost::noncopyable {
+  public:
+    child_table()
+      : children_(inline_)
+      , size_(0)
+      , capacity_(INLINE_SIZE)
+    {
+      std::fill(inline_, inline_ + INLINE_SIZE, nullptr);
+    }
+
+    size_t
+    size() const
+    {
+      return size_;
+    }
+
+    radix_trie*
+    find(const Key& key, std::size_t hash) const
+    {
+      if (!is_hashed()) {
+        for (uint32_t i = 0; i < size_; i++) {
+          if (children_[i]->hash_ == hash && children_[i]->keys_[0] == key)
+            return children_[i];
+        }
+        return 0;
+      }
+
+      for (size_t slot = hash & mask(); children_[slot] != 0; slot = (slot + 1) & mask()) {
+        if (children_[slot]->hash_ == hash && children_[slot]->keys_[0] == key)
+          return children_[slot];
+      }
+      return 0;
+    }
+
+    void
+    insert(radix_trie* child, allocator_type& allocator)
+    {
+      if (is_hashed() ? (size_ + 1) * 2 > capacity_ : size_ == capacity_)
+        grow(allocator);
+
+      place(child);
+      size_++;
+    }
+
+    /**
+     * @brief Put a node in place of a child whose span starts with the same component
+     */
+    void
+    replace(const radix_trie* child, radix_trie* node)
+    {
+      children_[index_of(child)] = node;
+    }
+
+    void
+    erase(const radix_trie* child)
+    {
+      size_t hole = index_of(child);
+      size_--;
+
+      if (!is_hashed()) {
+        children_[hole] = children_[size_];
+        children_[size_] = 0;
+        return;
+      }
+
+      // backward shift deletion: move up entries whose probe sequence crosses the hole
+      children_[hole] = 0;
+      for (size_t slot = (hole + 1) & mask(); children_[slot] != 0; slot = (slot + 1) & mask()) {
+        size_t home = children_[slot]->hash_ & mask();
+        // the entry stays if its home slot is cyclically within (hole, slot]
+        bool stays = hole < slot ? (home > hole && home <= slot) : (home > hole || home <= slot);
+        if (!stays) {
+          children_[hole] = children_[slot];
+          children_[slot] = 0;
+          hole = slot;
+        }
+      }
+    }
+
+    radix_trie*
+    first() const
+    {
+      return next_from(0);
+    }
+
+    radix_trie*
+    next(const radix_trie* child) const
+    {
+      return next_from(index_of(child) + 1);
+    }
+
+    void
+    clear_and_dispose(allocator_type& allocator)
+    {
+      for (uint32_t i = 0; i < capacity_; i++) {
+        if (children_[i] != 0)
+          dispose(children_[i]);
+      }
+
+      if (children_ != inline_)
+        allocator.deallocate(children_, capacity_ * sizeof(radix_trie*));
+      children_ = inline_;
+      size_ = 0;
+      capacity_ = INLINE_SIZE;
+      std::fill(inline_, inline_ + INLINE_SIZE, nullptr);
+    }
+
+  private:
+    bool
+    is_hashed() const
+    {
+      return capacity_ > LINEAR_SIZE;
+    }
+
+    size_t
+    mask() const
+    {
+      return capacity_ - 1;
+    }
+
+    size_t
+    index_of(const radix_trie* child) const
+    {
+      size_t slot = is_hashed() ? child->hash_ & mask() : 0;
+      while (children_[slot] != child) {
+        slot = (slot + 1) & mask(); // capacities are powers of two
+      }
+      return slot;
+    }
+
+    radix_trie*
+    next_from(size_t index) const
+    {
+      for (; index < capacity_; index++) {
+        if (children_[index] != 0)
+          return children_[index];
+      }
+      return 0;
+    }
+
+    void
+    place(radix_trie* child)
+    {
+      if (!is_hashed()) {
+        children_[size_] = child;
+        return;
+      }
+
+      size_t slot = child->hash_ & mask();
+      while (children_[slot] != 0) {
+        slot = (slot + 1) & mask();
+      }
+      children_[slot] = child;
+    }
+
+    void
+    grow(allocator_type& allocator)
+    {
+      radix_trie** oldChildren = children_;
+      uint32_t oldCapacity = capacity_;
+
+      capacity_ = capacity_ == LINEAR_SIZE ? MIN_HASHED_SIZE : capacity_ * 2;
+      children_ =
+        static_cast<radix_trie**>(allocator.allocate(capacity_ * sizeof(radix_trie*)));
+      std::fill(children_, children_ + capacity_, nullptr);
+
+      size_ = 0;
+      for (uint32_t i = 0; i < oldCapacity; i++) {
+        if (oldChildren[i] != 0) {
+          place(oldChildren[i]);
+          size_++;
+        }
+      }
+
+      if (oldChildren != inline_)
+        allocator.deallocate(oldChildren, oldCapacity * sizeof(radix_trie*));
+    }
+
+  private:
+    static const uint32_t INLINE_SIZE = 2;
+    static const uint32_t LINEAR_SIZE = 8;
+    static const uint32_t MIN_HASHED_SIZE = 32;
+
+    radix_trie** children_;
+    uint32_t size_;
+    uint32_t capacity_;
+    radix_trie* inline_[INLINE_SIZE];
+  };
+
+  radix_trie(allocator_type& allocator, radix_trie* parent)
+    : keys_(0)
+    , keyCount_(0)
+    , hash_(0)
+    , allocator_(&allocator)
+    , payload_(PayloadTraits::empty_payload)
+    , parent_(parent)
+  {
+  }
+
+  static void
+  dispose(radix_trie* node)
+  {
+    allocator_type& allocator = *node->allocator_;
+    node->~radix_trie();
+    allocator.deallocate(node, sizeof(radix_trie));
+  }
+
+  /**
+   * @brief Create a child holding @p count components of a key, starting from @p subkey
+   */
+  radix_trie*
+  new_child(typename FullKey::const_iterator subkey, size_t count, std::size_t hash)
+  {
+    radix_trie* node =
+      new (allocator_->allocate(sizeof(radix_trie))) radix_trie(*allocator_, this);
+    node->hash_ = hash;
+
+    Key* keys = node->allocate_keys(count);
+    for (size_t i = 0; i < count; i++, ++subkey) {
+      new (keys + i) Key(*subkey);
+    }
+    node->set_keys(keys, count);
+    return node;
+  }
+
+  /**
+   * @brief Match the span of the node against the key from @p subkey, the first component being
+   *        already matched by the child lookup
+   *
+   * Advances @p subkey and @p level past the matched components
+   *
+   * @returns number of matched components of the span
+   */
+  size_t
+  match(typename FullKey::const_iterator& subkey, size_t& level, size_t size) const
+  {
+    size_t matched = 1;
+    ++subkey;
+    ++level;
+    while (matched < keyCount_ && level < size && keys_[matched] == *subkey) {
+      ++matched;
+      ++subkey;
+      ++level;
+    }
+    return matched;
+  }
+
+  /**
+   * @brief Split the span of the node after @p count components
+   *
+   * The first part goes to a new node taking the place of this one, which keeps the rest of the
+   * span (and its payload and children) as the only child of the new node
+   *
+   * @returns the new node
+   */
+  radix_trie*
+  split(size_t count)
+  {
+    radix_trie* parent = parent_;
+    radix_trie* head =
+      new (allocator_->allocate(sizeof(radix_trie))) radix_trie(*allocator_, parent);
+    head->hash_ = hash_;
+
+    Key* headKeys = head->allocate_keys(count);
+    std::uninitialized_copy(keys_, keys_ + count, headKeys);
+    head->set_keys(headKeys, count);
+
+    Key* tailKeys = allocate_keys(keyCount_ - count);
+    std::uninitialized_copy(keys_ + count, keys_ + keyCount_, tailKeys);
+    size_t tailCount = keyCount_ - count;
+    parent->children_.replace(this, head);
+
+    set_keys(tailKeys, tailCount);
+    hash_ = boost::hash_value(keys_[0]);
+    parent_ = head;
+    head->children_.insert(this, *allocator_);
+    return head;
+  }
+
+  /**
+   * @brief Remove the node in favour of its only child, which takes its place with the joined span
+   */
+  void
+  merge_into_child()
+  {
+    radix_trie* child = children_.first();
+    children_.erase(child);
+
+    Key* keys = allocate_keys(keyCount_ + child->keyCount_);
+    std::uninitialized_copy(keys_, keys_ + keyCount_, keys);
+    std::uninitialized_copy(child->keys_, child->keys_ + child->keyCount_, keys + keyCount_);
+    child->set_keys(keys, keyCount_ + child->keyCount_);
+    child->hash_ = hash_;
+
+    parent_->children_.replace(this, child);
+    child->parent_ = parent_;
+
+    dispose(this); // delete this; basically, committing a suicide
+  }
+
+  Key*
+  allocate_keys(size_t count)
+  {
+    return static_cast<Key*>(allocator_->allocate(count * sizeof(Key)));
+  }
+
+  void
+  set_keys(Key* keys, size_t count)
+  {
+    release_keys();
+    keys_ = keys;
+    keyCount_ = count;
+  }
+
+  void
+  release_keys()
+  {
+    for (uint32_t i = 0; i < keyCount_; i++) {
+      keys_[i].~Key();
+    }
+    if (keys_ != 0)
+      allocator_->deallocate(keys_, keyCount_ * sizeof(Key));
+    keys_ = 0;
+    keyCount_ = 0;
+  }
+
+  radix_trie*
+  first_child() const
+  {
+    return children_.first();
+  }
+
+  radix_trie*
+  next_sibling() const
+  {
+    return parent_ != 0 ? parent_->children_.next(this) : 0;
+  }
+
+  template<class T, class NonConstT>
+  friend class radix_trie_iterator;
+
+  template<class T>
+  friend class radix_trie_point_iterator;
+
+public:
+  PolicyHook policy_hook_;
+
+private:
+  ////////////////////////////////////////////////
+  // Actual data
+  ////////////////////////////////////////////////
+
+  Key* keys_; ///< span of name components
+  uint32_t keyCount_;
+  std::size_t hash_; ///< hash of the first component of the span
+  allocator_type* allocator_;
+  child_table children_;
+
+  typename PayloadTraits::storage_type payload_;
+  radix_trie* parent_; // to make cleaning effective
+};
+
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
+inline void
+radix_trie<FullKey, PayloadTraits, PolicyHook, Allocator>::PrintStat(std::ostream& os) const
+{
+  os << "#";
+  for (uint32_t i = 0; i < keyCount_; i++) {
+    os << " " << keys_[i];
+  }
+  os << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": " << children_.size()
+     << " children" << std::endl;
+
+  for (radix_trie* subnode = children_.first(); subnode != 0; subnode = children_.next(subnode)) {
+    subnode->PrintStat(os);
+  }
+}
+
+template<class Trie, class NonConstTrie>
+class radix_trie_iterator {
+public:
+  radix_trie_iterator()
+    : trie_(0)
+  {
+  }
+  radix_trie_iterator(typename Trie::iterator item)
+    : trie_(item)
+  {
+  }
+  radix_trie_iterator(Trie& item)
+    : trie_(&item)
+  {
+  }
+
+  Trie& operator*()
+  {
+    return *trie_;
+  }
+  const Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->()
+  {
+    return trie_;
+  }
+  const Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(const radix_trie_iterator& other) const
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator!=(const radix_trie_iterator& other) const
+  {
+    return !(*this == other);
+  }
+
+  radix_trie_iterator<Trie, NonConstTrie>&
+  operator++(int)
+  {
+    NonConstTrie* child = trie_->first_child();
+    if (child != 0)
+      trie_ = child;
+    else
+      trie_ = goUp();
+    return *this;
+  }
+
+  radix_trie_iterator<Trie, NonConstTrie>&
+  operator++()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie*
+  goUp()
+  {
+    for (Trie* node = trie_; node != 0; node = node->parent_) {
+      NonConstTrie* sibling = node->next_sibling();
+      if (sibling != 0)
+        return sibling;
+    }
+    return 0;
+  }
+
+private:
+  Trie* trie_;
+};
+
+template<class Trie>
+class radix_trie_point_iterator {
+public:
+  radix_trie_point_iterator()
+    : trie_(0)
+  {
+  }
+  radix_trie_point_iterator(typename Trie::iterator item)
+    : trie_(item)
+  {
+  }
+  radix_trie_point_iterator(Trie& item)
+    : trie_(item.first_child())
+  {
+  }
+
+  Trie& operator*()
+  {
+    return *trie_;
+  }
+  const Trie& operator*() const
+  {
+    return *trie_;
+  }
+  Trie* operator->()
+  {
+    return trie_;
+  }
+  const Trie* operator->() const
+  {
+    return trie_;
+  }
+  bool
+  operator==(const radix_trie_point_iterator& other) const
+  {
+    return (trie_ == other.trie_);
+  }
+  bool
+  operator!=(const radix_trie_point_iterator& other) const
+  {
+    return !(*this == other);
+  }
+
+  radix_trie_point_iterator<Trie>&
+  operator++(int)
+  {
+    trie_ = trie_->next_sibling();
+    return *this;
+  }
+
+  radix_trie_point_iterator<Trie>&
+  operator++()
+  {
+    (*this)++;
+    return *this;
+  }
+
+private:
+  Trie* trie_;
+};
+
+/**
+ * @brief Policy traits adapter that puts the policy on top of radix_trie instead of trie
+ *
+ * For example, trie_with_policy<Name, ..., radix_policy_traits<lru_policy_traits>> is an LRU
+ * cache on a path-compressed trie, named "RadixLru"
+ */
+template<typename PolicyTraits>
+struct radix_policy_traits : public PolicyTraits {
+  /// @brief Name that can be used to identify the policy (for NS-3 object model and logging)
+  static std::string
+  GetName()
+  {
+    return "Radix" + PolicyTraits::GetName();
+  }
+};
+
+template<typename PolicyTraits>
+struct policy_trie<radix_policy_traits<PolicyTraits>> {
+  template<typename FullKey, typename PayloadTraits, typename Allocator>
+  struct apply {
+    typedef radix_trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type, Allocator>
+      type;
+  };
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // RADIX_TRIE_H_
@@ -91,6 +91,7 @@ struct random_policy_traits {
         : base_(base)
         , u_rand(CreateObject<UniformRandomVariable>())
         , max_size_(100)
+        , max_bytes_(0)
       {
         u_rand->SetAttribute("Min", UintegerValue(0));
         u_rand->SetAttribute("Max", UintegerValue(std::numeric_limits<uint32_t>::max()));
@@ -107,7 +108,15 @@ struct random_policy_traits {
       {
         get_order(item) = u_rand->GetValue();
 
-        if (max_size_ != 0 && policy_container::size() >= max_size_) {
+        /* PDRM Change */
+        size_t bytes = base_.get_payload_bytes(item);
+        if (max_bytes_ != 0 && bytes > max_bytes_)
+          return false; // would not fit even alone
+
+        // with a byte capacity several random elements may have to go, and the new one can still
+        // lose to a remaining one after some of them are gone
+        while (!policy_container::empty() && is_full(bytes)) {
+          /* PDRM Change */
           if (MemberHookLess<Container>()(*item, *policy_container::begin())) {
             // std::cout << "Cannot add. Signaling fail\n";
             // just return false. Indicating that insert "failed"
@@ -153,14 +162,39 @@ struct random_policy_traits {
         return max_size_;
       }
 
+      /* PDRM Change */
+      inline void
+      set_max_bytes(size_t max_bytes)
+      {
+        max_bytes_ = max_bytes;
+      }
+
+      inline size_t
+      get_max_bytes() const
+      {
+        return max_bytes_;
+      }
+      /* PDRM Change */
+
     private:
       type()
         : base_(*((Base*)0)){};
 
+      /* PDRM Change */
+      // no room for a new payload of the given size without evicting
+      inline bool
+      is_full(size_t bytes) const
+      {
+        return (max_size_ != 0 && policy_container::size() >= max_size_)
+               || (max_bytes_ != 0 && base_.get_bytes() + bytes > max_bytes_);
+      }
+      /* PDRM Change */
+
     private:
       Base& base_;
       Ptr<UniformRandomVariable> u_rand;
       size_t max_size_;
+      size_t max_bytes_;
     };
   };
 };
@@ -0,0 +1,165 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/**
+ * Copyright (c) 2011-2015  Regents of the University of California.
+ *
+ * This file is part of ndnSIM. See AUTHORS for complete list of ndnSIM authors and
+ * contributors.
+ *
+ * ndnSIM is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * ndnSIM is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * ndnSIM, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ **/
+
+#ifndef TRIE_ALLOCATOR_H_
+#define TRIE_ALLOCATOR_H_
+
+/// @cond include_hidden
+
+#include <boost/noncopyable.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <new>
+#include <vector>
+
+namespace ns3 {
+namespace ndn {
+namespace ndnSIM {
+
+/**
+ * @brief Allocator of trie nodes and bucket arrays: every block comes from operator new
+ */
+class heap_allocator : boost::noncopyable {
+public:
+  void*
+  allocate(std::size_t size)
+  {
+    return ::operator new(size);
+  }
+
+  void
+  deallocate(void* block, std::size_t size)
+  {
+    ::operator delete(block);
+  }
+};
+
+/**
+ * @brief Allocator of trie nodes and bucket arrays, owned by one trie
+ *
+ * Blocks up to 1 KiB are grouped in size classes of 16 bytes (nodes fall in one class, bucket
+ * arrays of each size in another) and carved from slabs, without per-block heap headers.  Freed
+ * blocks are reused within their class, slabs are only returned when the allocator is destroyed.
+ * Larger bucket arrays come from operator new.
+ */
+class slab_allocator : boost::noncopyable {
+public:
+  slab_allocator()
+  {
+    for (std::size_t size_class = 0; size_class < CLASS_COUNT; size_class++) {
+      free_[size_class] = nullptr;
+      slab_blocks_[size_class] = MIN_SLAB_BLOCKS;
+    }
+  }
+
+  ~slab_allocator()
+  {
+    for (void* slab : slabs_) {
+      ::operator delete(slab);
+    }
+  }
+
+  void*
+  allocate(std::size_t size)
+  {
+    if (size > MAX_BLOCK_SIZE)
+      return ::operator new(size);
+
+    std::size_t size_class = get_class(size);
+    if (free_[size_class] == nullptr)
+      add_slab(size_class);
+
+    free_block* block = free_[size_class];
+    free_[size_class] = block->next;
+    return block;
+  }
+
+  void
+  deallocate(void* block, std::size_t size)
+  {
+    if (size > MAX_BLOCK_SIZE) {
+      ::operator delete(block);
+      return;
+    }
+
+    std::size_t size_class = get_class(size);
+    free_block* freed = static_cast<free_block*>(block);
+    freed->next = free_[size_class];
+    free_[size_class] = freed;
+  }
+
+  /**
+   * @brief Get number of bytes taken from the heap for slabs
+   */
+  std::size_t
+  get_slab_bytes() const
+  {
+    return slab_bytes_;
+  }
+
+private:
+  struct free_block {
+    free_block* next;
+  };
+
+  static std::size_t
+  get_class(std::size_t size)
+  {
+    return size == 0 ? 0 : (size - 1) / GRANULARITY;
+  }
+
+  void
+  add_slab(std::size_t size_class)
+  {
+    std::size_t block_size = (size_class + 1) * GRANULARITY;
+    std::size_t blocks = slab_blocks_[size_class];
+    // slabs of a class grow with its use, so that small tries do not reserve much
+    slab_blocks_[size_class] =
+      std::min(blocks * 2, std::max<std::size_t>(MAX_SLAB_SIZE / block_size, 1u));
+
+    char* slab = static_cast<char*>(::operator new(blocks * block_size));
+    slabs_.push_back(slab);
+    slab_bytes_ += blocks * block_size;
+
+    for (std::size_t i = blocks; i-- > 0;) {
+      deallocate(slab + i * block_size, block_size);
+    }
+  }
+
+private:
+  static const std::size_t GRANULARITY = 16; // also the alignment of blocks
+  static const std::size_t MAX_BLOCK_SIZE = 1024;
+  static const std::size_t CLASS_COUNT = MAX_BLOCK_SIZE / GRANULARITY;
+  static const std::size_t MIN_SLAB_BLOCKS = 8;
+  static const std::size_t MAX_SLAB_SIZE = 64 * 1024;
+
+  free_block* free_[CLASS_COUNT];
+  std::size_t slab_blocks_[CLASS_COUNT];
+  std::vector<void*> slabs_;
+  std::size_t slab_bytes_ = 0;
+};
+
+} // ndnSIM
+} // ndn
+} // ns3
+
+/// @endcond
+
+#endif // TRIE_ALLOCATOR_H_
@@ -28,29 +28,71 @@ namespace ns3 {
 namespace ndn {
 namespace ndnSIM {
 
-template<typename FullKey, typename PayloadTraits, typename PolicyTraits>
+/* PDRM Change */
+/**
+ * @brief Trie implementation under trie_with_policy for the given policy traits
+ *
+ * trie by default, radix_trie for radix_policy_traits (radix-trie.hpp)
+ */
+template<typename PolicyTraits>
+struct policy_trie {
+  template<typename FullKey, typename PayloadTraits, typename Allocator>
+  struct apply {
+    typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type, Allocator> type;
+  };
+};
+/* PDRM Change */
+
+template<typename FullKey, typename PayloadTraits, typename PolicyTraits,
+         typename Allocator = heap_allocator>
 class trie_with_policy {
 public:
-  typedef trie<FullKey, PayloadTraits, typename PolicyTraits::policy_hook_type> parent_trie;
+  /* PDRM Change */
+  typedef typename policy_trie<PolicyTraits>::template apply<FullKey, PayloadTraits,
+                                                             Allocator>::type parent_trie;
+  /* PDRM Change */
 
   typedef typename parent_trie::iterator iterator;
   typedef typename parent_trie::const_iterator const_iterator;
 
+  /* PDRM Change */
+  typedef typename parent_trie::key_hashes_type key_hashes_type;
+  /* PDRM Change */
+
   typedef typename PolicyTraits::
-    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits>, parent_trie,
+    template policy<trie_with_policy<FullKey, PayloadTraits, PolicyTraits, Allocator>, parent_trie,
                     typename PolicyTraits::template container_hook<parent_trie>::type>::type
       policy_container;
 
+  /* PDRM Change */
+  /**
+   * @brief Function giving the number of bytes taken by the payload of a node
+   */
+  typedef std::size_t (*payload_bytes_getter)(const_iterator item);
+  /* PDRM Change */
+
   inline trie_with_policy(size_t bucketSize = 1, size_t bucketIncrement = 1)
-    : trie_(name::Component(), bucketSize, bucketIncrement)
+    : trie_(name::Component(), allocator_, bucketSize, bucketIncrement)
     , policy_(*this)
+    /* PDRM Change */
+    , payloadBytes_(0)
+    , bytes_(0)
+    /* PDRM Change */
   {
   }
 
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
   {
-    std::pair<iterator, bool> item = trie_.insert(key, payload);
+    return insert(key, key_hashes_type(key), payload);
+  }
+
+  /* PDRM Change */
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, const key_hashes_type& hashes,
+         typename PayloadTraits::insert_type payload)
+  {
+    std::pair<iterator, bool> item = trie_.insert(key, hashes, payload);
 
     if (item.second) // real insert
     {
@@ -59,6 +101,7 @@ public:
         item.first->erase(); // cannot insert
         return std::make_pair(end(), false);
       }
+      bytes_ += get_payload_bytes(item.first);
     }
     else {
       return std::make_pair(s_iterator_to(item.first), false);
@@ -66,19 +109,30 @@ public:
 
     return item;
   }
+  /* PDRM Change */
 
   inline void
   erase(const FullKey& key)
+  {
+    erase(key, key_hashes_type(key));
+  }
+
+  /* PDRM Change */
+  inline void
+  erase(const FullKey& key, const key_hashes_type& hashes)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(key, hashes);
 
-    if (!reachLast || lastItem->payload() == PayloadTraits::empty_payload)
+    // lastItem has the payload of the key only when it is also the longest match (a radix_trie
+    // node can be reached by a key ending inside its span)
+    if (!reachLast || foundItem != lastItem)
       return; // nothing to invalidate
 
     erase(lastItem);
   }
+  /* PDRM Change */
 
   inline void
   erase(iterator node)
@@ -87,6 +141,7 @@ public:
       return;
 
     policy_.erase(s_iterator_to(node));
+    bytes_ -= get_payload_bytes(node);
     node->erase(); // will do cleanup here
   }
 
@@ -95,7 +150,36 @@ public:
   {
     policy_.clear();
     trie_.clear();
+    bytes_ = 0;
+  }
+
+  /* PDRM Change */
+  /**
+   * @brief Set how the bytes taken by payloads are counted
+   *
+   * Until it is set, payloads take no bytes and byte capacities of the policies are never reached
+   */
+  void
+  set_payload_bytes_getter(payload_bytes_getter getter)
+  {
+    payloadBytes_ = getter;
+  }
+
+  std::size_t
+  get_payload_bytes(const_iterator item) const
+  {
+    return payloadBytes_ != 0 ? payloadBytes_(item) : 0;
+  }
+
+  /**
+   * @brief Get number of bytes taken by all payloads in the trie
+   */
+  std::size_t
+  get_bytes() const
+  {
+    return bytes_;
   }
+  /* PDRM Change */
 
   template<typename Modifier>
   bool
@@ -116,31 +200,47 @@ public:
    */
   inline iterator
   find_exact(const FullKey& key)
+  {
+    return find_exact(key, key_hashes_type(key));
+  }
+
+  /* PDRM Change */
+  inline iterator
+  find_exact(const FullKey& key, const key_hashes_type& hashes)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(key, hashes);
 
-    if (!reachLast || lastItem->payload() == PayloadTraits::empty_payload)
+    if (!reachLast || foundItem != lastItem)
       return end();
 
     return lastItem;
   }
+  /* PDRM Change */
 
   /**
    * @brief Find a node that has the longest common prefix with key (FIB/PIT lookup)
    */
   inline iterator
   longest_prefix_match(const FullKey& key)
+  {
+    return longest_prefix_match(key, key_hashes_type(key));
+  }
+
+  /* PDRM Change */
+  inline iterator
+  longest_prefix_match(const FullKey& key, const key_hashes_type& hashes)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(key, hashes);
     if (foundItem != trie_.end()) {
       policy_.lookup(s_iterator_to(foundItem));
     }
     return foundItem;
   }
+  /* PDRM Change */
 
   /**
    * @brief Find a node that has the longest common prefix with key (FIB/PIT lookup)
@@ -148,15 +248,24 @@ public:
   template<class Predicate>
   inline iterator
   longest_prefix_match_if(const FullKey& key, Predicate pred)
+  {
+    return longest_prefix_match_if(key, key_hashes_type(key), pred);
+  }
+
+  /* PDRM Change */
+  template<class Predicate>
+  inline iterator
+  longest_prefix_match_if(const FullKey& key, const key_hashes_type& hashes, Predicate pred)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find_if(key, pred);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find_if(key, hashes, pred);
     if (foundItem != trie_.end()) {
       policy_.lookup(s_iterator_to(foundItem));
     }
     return foundItem;
   }
+  /* PDRM Change */
 
   // /**
   //  * @brief Const version of the longest common prefix match
@@ -173,10 +282,17 @@ public:
    */
   inline iterator
   deepest_prefix_match(const FullKey& key)
+  {
+    return deepest_prefix_match(key, key_hashes_type(key));
+  }
+
+  /* PDRM Change */
+  inline iterator
+  deepest_prefix_match(const FullKey& key, const key_hashes_type& hashes)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(key, hashes);
 
     // guard in case we don't have anything in the trie
     if (lastItem == trie_.end())
@@ -193,6 +309,7 @@ public:
       return trie_.end();
     }
   }
+  /* PDRM Change */
 
   /**
    * @brief Find a node that has prefix at least as the key
@@ -200,10 +317,18 @@ public:
   template<class Predicate>
   inline iterator
   deepest_prefix_match_if(const FullKey& key, Predicate pred)
+  {
+    return deepest_prefix_match_if(key, key_hashes_type(key), pred);
+  }
+
+  /* PDRM Change */
+  template<class Predicate>
+  inline iterator
+  deepest_prefix_match_if(const FullKey& key, const key_hashes_type& hashes, Predicate pred)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(key, hashes);
 
     // guard in case we don't have anything in the trie
     if (lastItem == trie_.end())
@@ -221,6 +346,7 @@ public:
       return trie_.end();
     }
   }
+  /* PDRM Change */
 
   /**
    * @brief Find a node that has prefix at least as the key
@@ -231,17 +357,26 @@ public:
   template<class Predicate>
   inline iterator
   deepest_prefix_match_if_next_level(const FullKey& key, Predicate pred)
+  {
+    return deepest_prefix_match_if_next_level(key, key_hashes_type(key), pred);
+  }
+
+  /* PDRM Change */
+  template<class Predicate>
+  inline iterator
+  deepest_prefix_match_if_next_level(const FullKey& key, const key_hashes_type& hashes,
+                                     Predicate pred)
   {
     iterator foundItem, lastItem;
     bool reachLast;
-    std::tie(foundItem, reachLast, lastItem) = trie_.find(key);
+    std::tie(foundItem, reachLast, lastItem) = trie_.find(key, hashes);
 
     // guard in case we don't have anything in the trie
     if (lastItem == trie_.end())
       return trie_.end();
 
     if (reachLast) {
-      foundItem = lastItem->find_if_next_level(pred); // may or may not find something
+      foundItem = lastItem->find_if_next_level(pred, key.size()); // may or may not find something
       if (foundItem == trie_.end()) {
         return trie_.end();
       }
@@ -252,6 +387,7 @@ public:
       return trie_.end();
     }
   }
+  /* PDRM Change */
 
   iterator
   end() const
@@ -292,9 +428,24 @@ public:
       return &(*item);
   }
 
+  /* PDRM Change */
+  const Allocator&
+  getAllocator() const
+  {
+    return allocator_;
+  }
+  /* PDRM Change */
+
 private:
+  /* PDRM Change */
+  Allocator allocator_; // must outlive trie_
+  /* PDRM Change */
   parent_trie trie_;
   mutable policy_container policy_;
+  /* PDRM Change */
+  payload_bytes_getter payloadBytes_;
+  std::size_t bytes_;
+  /* PDRM Change */
 };
 
 } // ndnSIM
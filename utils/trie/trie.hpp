@@ -24,16 +24,20 @@
 
 #include "ns3/ndnSIM/model/ndn-common.hpp"
 
+/* PDRM Change */
+#include "trie-allocator.hpp"
+/* PDRM Change */
+
 #include "ns3/ptr.h"
 
 #include <boost/intrusive/unordered_set.hpp>
 #include <boost/intrusive/list.hpp>
 #include <boost/intrusive/set.hpp>
 #include <boost/functional/hash.hpp>
-#include <boost/interprocess/smart_ptr/unique_ptr.hpp>
 #include <tuple>
 #include <boost/foreach.hpp>
 #include <boost/mpl/if.hpp>
+#include <boost/noncopyable.hpp>
 
 namespace ns3 {
 namespace ndn {
@@ -98,24 +102,69 @@ struct non_pointer_traits {
 template<typename Payload, typename BasePayload>
 Payload non_pointer_traits<Payload, BasePayload>::empty_payload = Payload();
 
+/* PDRM Change */
+/////////////////////////////////////////////////////
+// Hashes of the components of a key, computed once per key and used at every level of the trie
+//
+template<typename FullKey>
+class key_hashes : boost::noncopyable {
+public:
+  explicit key_hashes(const FullKey& key)
+    : size_(key.size())
+    , hashes_(size_ <= INLINE_SIZE ? inline_ : new std::size_t[size_])
+  {
+    std::size_t* hash = hashes_;
+    BOOST_FOREACH (const typename FullKey::value_type& subkey, key) {
+      *hash++ = boost::hash_value(subkey);
+    }
+  }
+
+  ~key_hashes()
+  {
+    if (hashes_ != inline_)
+      delete[] hashes_;
+  }
+
+  std::size_t
+  size() const
+  {
+    return size_;
+  }
+
+  std::size_t operator[](std::size_t level) const
+  {
+    return hashes_[level];
+  }
+
+private:
+  static const std::size_t INLINE_SIZE = 8; // enough for names of PDRM chunks
+
+  std::size_t size_;
+  std::size_t inline_[INLINE_SIZE];
+  std::size_t* hashes_;
+};
+/* PDRM Change */
+
 ////////////////////////////////////////////////////
 // forward declarations
 //
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook,
+         typename Allocator = heap_allocator>
 class trie;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+operator<<(std::ostream& os,
+           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+operator==(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& a,
+           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& b);
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+hash_value(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node);
 
 ///////////////////////////////////////////////////
 // actual definition
@@ -126,7 +175,7 @@ class trie_iterator;
 template<class T>
 class trie_point_iterator;
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 class trie {
 public:
   typedef typename FullKey::value_type Key;
@@ -142,19 +191,35 @@ public:
 
   typedef PayloadTraits payload_traits;
 
-  inline trie(const Key& key, size_t bucketSize = 1, size_t bucketIncrement = 1)
+  /* PDRM Change */
+  typedef key_hashes<FullKey> key_hashes_type;
+  typedef Allocator allocator_type;
+  /* PDRM Change */
+
+  /* PDRM Change */
+  /**
+   * @brief Create a trie node; the allocator provides memory for all nodes and bucket arrays of
+   *        the trie and must outlive it
+   */
+  inline trie(const Key& key, allocator_type& allocator, size_t bucketSize = 1,
+              size_t bucketIncrement = 1)
+    : trie(key, boost::hash_value(key), allocator, bucketSize, bucketIncrement)
+  {
+  }
+
+  inline trie(const Key& key, std::size_t hash, allocator_type& allocator, size_t bucketSize,
+              size_t bucketIncrement)
     : key_(key)
+    , hash_(hash)
     , initialBucketSize_(bucketSize)
     , bucketIncrement_(bucketIncrement)
-    , bucketSize_(initialBucketSize_)
-    , buckets_(new bucket_type[bucketSize_]) // cannot use normal pointer, because lifetime of
-                                             // buckets should be larger than lifetime of the
-                                             // container
-    , children_(bucket_traits(buckets_.get(), bucketSize_))
+    , buckets_(allocator, initialBucketSize_)
+    , children_(bucket_traits(buckets_.get(), buckets_.size()))
     , payload_(PayloadTraits::empty_payload)
     , parent_(nullptr)
   {
   }
+  /* PDRM Change */
 
   inline ~trie()
   {
@@ -184,30 +249,45 @@ public:
   }
 
   // actual entry
-  friend bool operator==<>(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-                           const trie<FullKey, PayloadTraits, PolicyHook>& b);
+  friend bool operator==<>(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& a,
+                           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& b);
 
   friend std::size_t
-  hash_value<>(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node);
+  hash_value<>(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node);
 
   inline std::pair<iterator, bool>
   insert(const FullKey& key, typename PayloadTraits::insert_type payload)
+  {
+    return insert(key, key_hashes_type(key), payload);
+  }
+
+  /* PDRM Change */
+  /**
+   * @brief Insert with the component hashes of the key already computed
+   */
+  inline std::pair<iterator, bool>
+  insert(const FullKey& key, const key_hashes_type& hashes,
+         typename PayloadTraits::insert_type payload)
   {
     trie* trieNode = this;
+    size_t level = 0;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      std::size_t hash = hashes[level++];
+      typename unordered_set::iterator item = trieNode->find_child(subkey, hash);
       if (item == trieNode->children_.end()) {
-        trie* newNode = new trie(subkey, initialBucketSize_, bucketIncrement_);
+        allocator_type& allocator = buckets_.get_allocator();
+        trie* newNode = new (allocator.allocate(sizeof(trie)))
+          trie(subkey, hash, allocator, initialBucketSize_, bucketIncrement_);
         // std::cout << "new " << newNode << "\n";
         newNode->parent_ = trieNode;
 
-        if (trieNode->children_.size() >= trieNode->bucketSize_) {
-          trieNode->bucketSize_ += trieNode->bucketIncrement_;
+        if (trieNode->children_.size() >= trieNode->buckets_.size()) {
+          bucket_array newBuckets(allocator,
+                                  trieNode->buckets_.size() + trieNode->bucketIncrement_);
           trieNode->bucketIncrement_ *= 2; // increase bucketIncrement exponentially
 
-          buckets_array newBuckets(new bucket_type[trieNode->bucketSize_]);
-          trieNode->children_.rehash(bucket_traits(newBuckets.get(), trieNode->bucketSize_));
+          trieNode->children_.rehash(bucket_traits(newBuckets.get(), newBuckets.size()));
           trieNode->buckets_.swap(newBuckets);
         }
 
@@ -227,6 +307,7 @@ public:
     else
       return std::make_pair(trieNode, false);
   }
+  /* PDRM Change */
 
   /**
    * @brief Removes payload (if it exists) and if there are no children, prunes parents trie
@@ -289,13 +370,24 @@ public:
    */
   inline std::tuple<iterator, bool, iterator>
   find(const FullKey& key)
+  {
+    return find(key, key_hashes_type(key));
+  }
+
+  /* PDRM Change */
+  /**
+   * @brief Perform the longest prefix match, with the component hashes of the key already computed
+   */
+  inline std::tuple<iterator, bool, iterator>
+  find(const FullKey& key, const key_hashes_type& hashes)
   {
     trie* trieNode = this;
     iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
     bool reachLast = true;
+    size_t level = 0;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item = trieNode->find_child(subkey, hashes[level++]);
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -310,6 +402,7 @@ public:
 
     return std::make_tuple(foundNode, reachLast, trieNode);
   }
+  /* PDRM Change */
 
   /**
    * @brief Perform the longest prefix match satisfying preficate
@@ -320,13 +413,26 @@ public:
   template<class Predicate>
   inline std::tuple<iterator, bool, iterator>
   find_if(const FullKey& key, Predicate pred)
+  {
+    return find_if(key, key_hashes_type(key), pred);
+  }
+
+  /* PDRM Change */
+  /**
+   * @brief Perform the longest prefix match satisfying preficate, with the component hashes of the
+   *        key already computed
+   */
+  template<class Predicate>
+  inline std::tuple<iterator, bool, iterator>
+  find_if(const FullKey& key, const key_hashes_type& hashes, Predicate pred)
   {
     trie* trieNode = this;
     iterator foundNode = (payload_ != PayloadTraits::empty_payload) ? this : 0;
     bool reachLast = true;
+    size_t level = 0;
 
     BOOST_FOREACH (const Key& subkey, key) {
-      typename unordered_set::iterator item = trieNode->children_.find(subkey);
+      typename unordered_set::iterator item = trieNode->find_child(subkey, hashes[level++]);
       if (item == trieNode->children_.end()) {
         reachLast = false;
         break;
@@ -342,6 +448,7 @@ public:
 
     return std::make_tuple(foundNode, reachLast, trieNode);
   }
+  /* PDRM Change */
 
   /**
    * @brief Find next payload of the sub-trie
@@ -354,7 +461,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload)
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
     for (typename trie::unordered_set::iterator subnode = children_.begin();
          subnode != children_.end(); subnode++)
     // BOOST_FOREACH (trie &subnode, children_)
@@ -380,7 +487,7 @@ public:
     if (payload_ != PayloadTraits::empty_payload && pred(payload_))
       return this;
 
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
     for (typename trie::unordered_set::iterator subnode = children_.begin();
          subnode != children_.end(); subnode++)
     // BOOST_FOREACH (const trie &subnode, children_)
@@ -406,7 +513,7 @@ public:
   inline const iterator
   find_if_next_level(Predicate pred)
   {
-    typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+    typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
     for (typename trie::unordered_set::iterator subnode = children_.begin();
          subnode != children_.end(); subnode++) {
       if (pred(subnode->key())) {
@@ -417,6 +524,21 @@ public:
     return 0;
   }
 
+  /* PDRM Change */
+  /**
+   * @brief Same as find_if_next_level (pred), for the node returned by find for a key of @p level
+   *        components
+   *
+   * The level is implied by the node here, the overload is for radix_trie
+   */
+  template<class Predicate>
+  inline const iterator
+  find_if_next_level(Predicate pred, size_t level)
+  {
+    return find_if_next_level(pred);
+  }
+  /* PDRM Change */
+
   iterator
   end()
   {
@@ -457,21 +579,47 @@ public:
   PrintStat(std::ostream& os) const;
 
 private:
-  // The disposer object function
-  struct trie_delete_disposer {
-    void
-    operator()(trie* delete_this)
+  /* PDRM Change */
+  // Lookup of a child by a component whose hash is already known: buckets are selected by the
+  // hash, and components are only compared when hashes are equal
+  struct hashed_key {
+    const Key& key;
+    std::size_t hash;
+  };
+
+  struct hashed_key_hash {
+    std::size_t
+    operator()(const hashed_key& key) const
     {
-      delete delete_this;
+      return key.hash;
     }
   };
 
-  template<class D>
-  struct array_disposer {
+  struct hashed_key_equal {
+    bool
+    operator()(const hashed_key& key, const trie& node) const
+    {
+      return key.hash == node.hash_ && key.key == node.key_;
+    }
+
+    bool
+    operator()(const trie& node, const hashed_key& key) const
+    {
+      return (*this)(key, node);
+    }
+  };
+  /* PDRM Change */
+
+  // The disposer object function
+  struct trie_delete_disposer {
     void
-    operator()(D* array)
+    operator()(trie* delete_this)
     {
-      delete[] array;
+      /* PDRM Change */
+      allocator_type& allocator = delete_this->buckets_.get_allocator();
+      delete_this->~trie();
+      allocator.deallocate(delete_this, sizeof(trie));
+      /* PDRM Change */
     }
   };
 
@@ -492,6 +640,71 @@ private:
   typedef typename unordered_set::bucket_type bucket_type;
   typedef typename unordered_set::bucket_traits bucket_traits;
 
+  /* PDRM Change */
+  /**
+   * @brief Bucket array of the children container, taken from the trie allocator
+   *
+   * Must outlive the container, hence it is declared before children_
+   */
+  class bucket_array : boost::noncopyable {
+  public:
+    bucket_array(allocator_type& allocator, size_t size)
+      : allocator_(&allocator)
+      , buckets_(static_cast<bucket_type*>(allocator.allocate(size * sizeof(bucket_type))))
+      , size_(size)
+    {
+      for (size_t i = 0; i < size_; i++) {
+        new (buckets_ + i) bucket_type();
+      }
+    }
+
+    ~bucket_array()
+    {
+      for (size_t i = 0; i < size_; i++) {
+        buckets_[i].~bucket_type();
+      }
+      allocator_->deallocate(buckets_, size_ * sizeof(bucket_type));
+    }
+
+    void
+    swap(bucket_array& other)
+    {
+      std::swap(allocator_, other.allocator_);
+      std::swap(buckets_, other.buckets_);
+      std::swap(size_, other.size_);
+    }
+
+    bucket_type*
+    get() const
+    {
+      return buckets_;
+    }
+
+    size_t
+    size() const
+    {
+      return size_;
+    }
+
+    allocator_type&
+    get_allocator() const
+    {
+      return *allocator_;
+    }
+
+  private:
+    allocator_type* allocator_;
+    bucket_type* buckets_;
+    size_t size_;
+  };
+
+  typename unordered_set::iterator
+  find_child(const Key& key, std::size_t hash)
+  {
+    return children_.find(hashed_key{key, hash}, hashed_key_hash(), hashed_key_equal());
+  }
+  /* PDRM Change */
+
   template<class T, class NonConstT>
   friend class trie_iterator;
 
@@ -503,26 +716,30 @@ private:
   ////////////////////////////////////////////////
 
   Key key_; ///< name component
+  /* PDRM Change */
+  std::size_t hash_; ///< hash of the name component, computed once
+  /* PDRM Change */
 
   size_t initialBucketSize_;
   size_t bucketIncrement_;
 
-  size_t bucketSize_;
-  typedef boost::interprocess::unique_ptr<bucket_type, array_disposer<bucket_type>> buckets_array;
-  buckets_array buckets_;
+  /* PDRM Change */
+  bucket_array buckets_; // lifetime of buckets should be larger than lifetime of the container
+  /* PDRM Change */
   unordered_set children_;
 
   typename PayloadTraits::storage_type payload_;
   trie* parent_; // to make cleaning effective
 };
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 inline std::ostream&
-operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+operator<<(std::ostream& os,
+           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node)
 {
   os << "# " << trie_node.key_ << ((trie_node.payload_ != PayloadTraits::empty_payload) ? "*" : "")
      << std::endl;
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
 
   for (typename trie::unordered_set::const_iterator subnode = trie_node.children_.begin();
        subnode != trie_node.children_.end(); subnode++)
@@ -546,9 +763,9 @@ operator<<(std::ostream& os, const trie<FullKey, PayloadTraits, PolicyHook>& tri
   return os;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 inline void
-trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
+trie<FullKey, PayloadTraits, PolicyHook, Allocator>::PrintStat(std::ostream& os) const
 {
   os << "# " << key_ << ((payload_ != PayloadTraits::empty_payload) ? "*" : "") << ": "
      << children_.size() << " children" << std::endl;
@@ -557,7 +774,7 @@ trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
   }
   os << "\n";
 
-  typedef trie<FullKey, PayloadTraits, PolicyHook> trie;
+  typedef trie<FullKey, PayloadTraits, PolicyHook, Allocator> trie;
   for (typename trie::unordered_set::const_iterator subnode = children_.begin();
        subnode != children_.end(); subnode++)
   // BOOST_FOREACH (const trie &subnode, children_)
@@ -566,19 +783,21 @@ trie<FullKey, PayloadTraits, PolicyHook>::PrintStat(std::ostream& os) const
   }
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 inline bool
-operator==(const trie<FullKey, PayloadTraits, PolicyHook>& a,
-           const trie<FullKey, PayloadTraits, PolicyHook>& b)
+operator==(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& a,
+           const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& b)
 {
   return a.key_ == b.key_;
 }
 
-template<typename FullKey, typename PayloadTraits, typename PolicyHook>
+template<typename FullKey, typename PayloadTraits, typename PolicyHook, typename Allocator>
 inline std::size_t
-hash_value(const trie<FullKey, PayloadTraits, PolicyHook>& trie_node)
+hash_value(const trie<FullKey, PayloadTraits, PolicyHook, Allocator>& trie_node)
 {
-  return boost::hash_value(trie_node.key_);
+  /* PDRM Change */
+  return trie_node.hash_;
+  /* PDRM Change */
 }
 
 template<class Trie, class NonConstTrie> // hack for boost < 1.47